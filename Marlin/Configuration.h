@@ -506,6 +506,33 @@
 
 #endif // PIDTEMP
 
+/**
+ * Model Predictive Control for hotends
+ *
+ * Use a thermal model of each hotend (heater power, heat capacity, heat lost to
+ * the air, the part cooling fan and the filament) to predict the power needed to
+ * reach and hold the target, correcting the model against the sensor as it goes.
+ * Responds to fan and extrusion changes before the temperature moves.
+ *
+ * Disable PIDTEMP to use MPCTEMP. Set the heater power and filament heat
+ * capacity below, then run "M306 T" to measure the rest, and M500 to save.
+ */
+//#define MPCTEMP
+
+#if ENABLED(MPCTEMP)
+  // One value per hotend, or one value for all
+  #define MPC_HEATER_POWER { 40.0f }                  // (W) Heater cartridge power
+  #define MPC_BLOCK_HEAT_CAPACITY { 16.7f }           // (J/K) Heat capacity of the heater block and nozzle
+  #define MPC_SENSOR_RESPONSIVENESS { 0.22f }         // (K/s per ∆K) How fast the sensor follows the block
+  #define MPC_AMBIENT_XFER_COEFF { 0.068f }           // (W/K) Heat lost to the air with the part fan off
+  #define MPC_AMBIENT_XFER_COEFF_FAN255 { 0.097f }    // (W/K) Heat lost to the air with the part fan at full speed
+  #define MPC_FILAMENT_HEAT_CAPACITY_PERMM { 5.6e-3f } // (J/K/mm) 1.75mm PLA: 5.6e-3, 2.85mm PLA: 1.4e-2
+
+  #define MPC_SMOOTHING_FACTOR 0.5f                   // (0.0...1.0) How fast the model is pulled toward the sensor reading
+  #define MPC_MIN_AMBIENT_CHANGE 1.0f                 // (K/s) Ambient temperature correction rate
+  #define MPC_STEADYSTATE 0.5f                        // (K/s) Block temperature change below which the ambient estimate is corrected
+#endif
+
 //===========================================================================
 //====================== PID > Bed Temperature Control ======================
 //===========================================================================
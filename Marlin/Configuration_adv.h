@@ -115,6 +115,32 @@
   #define CHAMBER_BETA                 3950    // Beta value
 #endif
 
+/**
+ * Fast user thermistors
+ *
+ * Convert readings of TEMP_SENSOR 1000 through a table built from the
+ * thermistor's parameters, instead of evaluating the formula (a log and a
+ * divide) for every reading. When M305 changes the parameters or settings
+ * load, the table is rebuilt one entry per idle() call, and readings use the
+ * formula until it's done (USER_THERMISTOR_TABLE_SIZE calls per thermistor).
+ * 'M305 E' waits for the build, then reports the largest error against the
+ * formula, usually 0.1-0.2C. Uses 4 bytes of RAM per entry.
+ */
+//#define FAST_USER_THERMISTORS
+#if ENABLED(FAST_USER_THERMISTORS)
+  #define USER_THERMISTOR_TABLE_SIZE 128  // Table entries for each user thermistor (32-255)
+#endif
+
+/**
+ * Fast thermistor table lookup
+ *
+ * Convert table thermistor readings through a 256-cell grid over the ADC
+ * range, built at compile time, instead of a bisect search of the table.
+ * Temperatures are the same as the table gives. Uses 256 bytes of flash
+ * for each table in use.
+ */
+//#define FAST_THERMISTOR_LOOKUP
+
 //
 // Hephestos 2 24V heated bed upgrade kit.
 // https://store.bq.com/en/heated-bed-kit-hephestos2
@@ -274,6 +300,23 @@
   #endif
 #endif
 
+/**
+ * Extrusion Feed-Forward
+ *
+ * Heat for the filament the planner is about to extrude, instead of waiting for
+ * the temperature to drop. The melt rate (mm³/s) is estimated from the moves queued
+ * for the next EXTRUSION_LOOKAHEAD_MS, timing each move along its acceleration
+ * and deceleration, with the M200 filament diameter. The heater constants are
+ * per mm of DEFAULT_NOMINAL_FILAMENT_DIA filament.
+ *
+ * With MPCTEMP the model plans heater power for that melt rate.
+ * With PID_EXTRUSION_SCALING the Kc term uses it in place of the E step history.
+ */
+//#define EXTRUSION_FEEDFORWARD
+#if ENABLED(EXTRUSION_FEEDFORWARD)
+  #define EXTRUSION_LOOKAHEAD_MS 300  // (ms) Window of queued moves to average
+#endif
+
 /**
  * Automatic Temperature Mode
  *
@@ -1274,6 +1317,40 @@
   // Add an optimized binary file transfer mode, initiated with 'M28 B1'
   //#define BINARY_FILE_TRANSFER
 
+  #if ENABLED(BINARY_FILE_TRANSFER)
+    // Also take packed G0-G3 moves in binary mode, with no G-code text to parse.
+    // Requires FASTER_GCODE_VALUES.
+    //#define BINARY_MOTION_PROTOCOL
+  #endif
+
+  /**
+   * Pre-parsed G-code cache for faster SD printing.
+   * 'M36 file.gco' parses the file once and saves FILE.GCT next to it.
+   * The file is parsed a few lines at a time between commands, and waits
+   * while another file is open. 'M36' alone reports the progress.
+   * While the cache matches the file's size and date, printing the file
+   * loads the parsed commands directly, with no G-code text to parse.
+   * Lines that can't be stored as values (e.g., string arguments) stay as text.
+   * Progress, M26 and power-loss recovery still use the G-code file positions.
+   * Requires FASTER_GCODE_VALUES.
+   */
+  //#define SD_GCODE_CACHE
+
+  /**
+   * Read ahead in the file being printed with multi-block reads (CMD18).
+   * Buffers are filled in idle time while commands come from a full one,
+   * so a slow card read is less likely to starve the planner.
+   * Reads are polled from idle. Only STM32F1 SDIO reads a block in the
+   * background with DMA. On SPI only the wait for each block is polled,
+   * and the 512 bytes are still received blocking (~0.5ms at 8MHz).
+   * M27 reports the bytes read ahead and the reads that had to wait.
+   */
+  //#define SD_READ_AHEAD
+  #if ENABLED(SD_READ_AHEAD)
+    #define SD_READ_AHEAD_BUFFERS 2   // Rotating buffers (2-4)
+    #define SD_READ_AHEAD_BLOCKS  2   // 512-byte blocks in each buffer (1-8)
+  #endif
+
   /**
    * Set this option to one of the following (or the board's defaults apply):
    *
@@ -1819,6 +1896,18 @@
  */
 //#define MAXIMUM_STEPPER_RATE 250000
 
+/**
+ * Batched step pulses
+ *
+ * Step pins on the same GPIO port (with the same INVERT_*_STEP_PIN) are set
+ * and cleared together with one port write, instead of one write per pin.
+ * This cuts the skew between axes. The step rate limits are not changed.
+ * Axes with dual / multiple drivers keep their own pin writes.
+ * The grouping is worked out at compile time from the board's pins.
+ * Requires a HAL with port writes (LPC176x, Linux).
+ */
+//#define BATCHED_STEP_PULSES
+
 // @section temperature
 
 // Control heater 0 and heater 1 in parallel.
@@ -1840,12 +1929,82 @@
   #define BLOCK_BUFFER_SIZE 16
 #endif
 
+/**
+ * Adaptive block buffer
+ *
+ * Size the planner buffer at boot from the free RAM reported by the HAL.
+ * The largest power of 2 up to BLOCK_BUFFER_SIZE_MAX that leaves at least
+ * BLOCK_BUFFER_RAM_RESERVE bytes free is allocated. BLOCK_BUFFER_SIZE is
+ * the minimum. No static ring is kept. M503 reports the chosen depth.
+ */
+//#define ADAPTIVE_BLOCK_BUFFER
+#if ENABLED(ADAPTIVE_BLOCK_BUFFER)
+  #define BLOCK_BUFFER_SIZE_MAX     64  // Power of 2, up to 128
+  #define BLOCK_BUFFER_RAM_RESERVE 4096 // (bytes) Free RAM to leave for the stack and heap
+#endif
+
+/**
+ * Incremental look-ahead replanning
+ *
+ * Stop the planner's reverse pass at the first block whose entry speed
+ * doesn't change, then run the forward pass and trapezoid update only from
+ * there. Gives the same plan with much less work per added move, so larger
+ * BLOCK_BUFFER_SIZE values become affordable on 32-bit boards.
+ * PLANNER_BENCHMARK checks each replan against a full one.
+ */
+//#define INCREMENTAL_REPLANNING
+
+/**
+ * Step segment queue
+ *
+ * Cut each planner block into short time slices in the main loop, with the
+ * step timer interval of each slice worked out in advance. The Stepper ISR
+ * then just takes the next interval, with no acceleration or S-curve math,
+ * leaving more time for step pulses and Linear Advance.
+ * Only blocks the planner can't speed up any more are compiled ahead.
+ * If the main loop stalls, or the queue reaches the newest blocks, the
+ * Stepper ISR does the math itself. PLANNER_BENCHMARK checks this by
+ * starving the queue and by feeding in one block at a time.
+ */
+//#define STEP_SEGMENT_QUEUE
+#if ENABLED(STEP_SEGMENT_QUEUE)
+  #define STEP_SEGMENTS_PER_SECOND 1000 // Rate updates per second while accelerating
+  #define STEP_SEGMENT_QUEUE_SIZE    32 // Slices held for the Stepper ISR. Power of 2, up to 256.
+#endif
+
+/**
+ * Vector Junction Deviation
+ *
+ * Compute the junction deviation unit vectors, dot product and axis limits
+ * on packed 4-lane XYZE vectors, with a fast reciprocal square root.
+ * Uses SSE on the native Linux build. Elsewhere the lanes are unrolled, and
+ * the rsqrt is VSQRT and VDIV on an FPU (Cortex-M4F/M7) or an integer estimate
+ * with Newton-Raphson steps without one.
+ * Junction speeds stay within 0.01% of the scalar math; PLANNER_BENCHMARK
+ * checks this on real moves. Requires Junction Deviation (no CLASSIC_JERK).
+ */
+//#define VECTOR_JUNCTION_DEVIATION
+
 // @section serial
 
 // The ASCII buffer for serial input
 #define MAX_CMD_SIZE 96
 #define BUFSIZE 4
 
+/**
+ * Command Ring Buffer
+ *
+ * Store queued commands back to back in a ring of COMMAND_RING_BYTES instead
+ * of BUFSIZE slots of MAX_CMD_SIZE bytes. A command takes its length plus 2
+ * bytes, so a typical 30-byte G1 uses a third of a slot. The first serial
+ * port receives straight into the ring, with no line buffer or copy.
+ * BUFSIZE is then just the most commands to queue. Raise it to fill the ring.
+ */
+//#define COMMAND_RING_BUFFER
+#if ENABLED(COMMAND_RING_BUFFER)
+  #define COMMAND_RING_BYTES 384  // (bytes) At least 4 * MAX_CMD_SIZE
+#endif
+
 // Transmission to Host Buffer Size
 // To save 386 bytes of PROGMEM (and TX_BUFFER_SIZE+3 bytes of RAM) set to 0.
 // To buffer a simple "ok" you need 4 bytes.
@@ -1861,6 +2020,30 @@
 // :[0, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048]
 //#define RX_BUFFER_SIZE 1024
 
+/**
+ * Serial DMA
+ *
+ * Receive on SERIAL_PORT by a circular DMA transfer into the RX buffer
+ * instead of an interrupt per byte. The command queue reads the DMA
+ * counter to see what has arrived. With EMERGENCY_PARSER the new bytes
+ * are scanned on every idle() and as each half of the buffer fills.
+ *
+ * The buffer is overwritten if more than RX_BUFFER_SIZE - 1 bytes go
+ * unread, so use a larger RX_BUFFER_SIZE or host flow control (WINDOWED_OK).
+ *
+ * Supported on STM32 (stm32duino) and the LINUX simulator.
+ */
+//#define SERIAL_DMA
+#if ENABLED(SERIAL_DMA)
+  // STM32: The DMA stream wired to the SERIAL_PORT USART RX (see the Reference Manual)
+  //#define SERIAL_DMA_STREAM  DMA2_Stream5   // e.g., USART1 RX on STM32F4
+  //#define SERIAL_DMA_CHANNEL DMA_CHANNEL_4  // F2 / F4 / F7
+  //#define SERIAL_DMA_REQUEST DMA_REQUEST_USART1_RX // Parts with DMAMUX
+  // STM32 with EMERGENCY_PARSER: The interrupt of that DMA stream
+  //#define SERIAL_DMA_IRQ        DMA2_Stream5_IRQn
+  //#define SERIAL_DMA_IRQHandler DMA2_Stream5_IRQHandler
+#endif
+
 #if RX_BUFFER_SIZE >= 1024
   // Enable to have the controller send XON/XOFF control characters to
   // the host to signal the RX buffer is becoming full.
@@ -1890,6 +2073,23 @@
  */
 //#define EMERGENCY_PARSER
 
+/**
+ * Fair command intake for SERIAL_PORT and SERIAL_PORT_2
+ *
+ * Give each port a share of the command queue (BUFSIZE) by weight, so a
+ * chatty port (e.g., a WiFi module polling M105) can't starve the print host.
+ * A port past its share stops being read while the other port has input
+ * waiting and is owed slots. Otherwise the free slots go to whichever port
+ * has input.
+ *
+ * With EMERGENCY_PARSER, M108, M112 and M410 take a priority lane. They get
+ * their "ok" as soon as they're read, without taking a queue slot.
+ */
+//#define SERIAL_FAIR_INTAKE
+#if ENABLED(SERIAL_FAIR_INTAKE)
+  #define SERIAL_PORT_WEIGHTS { 3, 1 } // Queue share of { SERIAL_PORT, SERIAL_PORT_2 }
+#endif
+
 // Bad Serial-connections can miss a received command by sending an 'ok'
 // Therefore some clients abort after 30 seconds in a timeout.
 // Some other clients start sending commands while receiving a 'wait'.
@@ -1899,6 +2099,17 @@
 // Some clients will have this feature soon. This could make the NO_TIMEOUTS unnecessary.
 //#define ADVANCED_OK
 
+/**
+ * Windowed "ok" flow control. After 'M576 S1' the host gets credits for
+ * free command slots and RX bytes in place of one "ok" per line, so it can
+ * keep several lines in flight and the planner won't starve on USB latency.
+ * Line numbers, checksums and "Resend:" work as before. See queue.h.
+ */
+//#define WINDOWED_OK
+#if ENABLED(WINDOWED_OK)
+  #define WINDOWED_OK_BATCH 2  // Return line credits this many at a time
+#endif
+
 // Printrun may have trouble receiving long strings all at once.
 // This option inserts short delays between lines of serial output.
 #define SERIAL_OVERRUN_PROTECTION
@@ -3124,6 +3335,7 @@
 
 #if ENABLED(FASTER_GCODE_PARSER)
   //#define GCODE_QUOTED_STRINGS  // Support for quoted string parameters
+  //#define FASTER_GCODE_VALUES   // Decode numbers while parsing, without strtof. Uses 110 bytes of SRAM.
 #endif
 
 //#define GCODE_CASE_INSENSITIVE  // Accept G-code sent to the firmware in lowercase
@@ -3504,3 +3716,32 @@
 
 // Enable Marlin dev mode which adds some special commands
 //#define MARLIN_DEV_MODE
+
+//
+// M124 - Report the CPU cycles spent in the Stepper and Temperature ISRs
+// (min / avg / max and a histogram), measured with the DWT cycle counter
+// on ARM Cortex-M3/M4/M7 and with the stepper timer on AVR.
+//
+//#define ISR_PROFILER
+
+/**
+ * Planner Benchmark (HAL/LINUX only)
+ *
+ * Build the native Linux target as a benchmark that replays the G-code
+ * files given on the command line as fast as possible, running the stepper
+ * ISR inline instead of from timers. Reports blocks/s through buffer_line,
+ * time spent in recalculate(), reverse_pass() and forward_pass(), and a
+ * histogram of step ISR rates. Heater waits, dwells and homing are skipped.
+ */
+//#define PLANNER_BENCHMARK
+
+/**
+ * Virtual time (HAL/LINUX only)
+ *
+ * Run the native Linux target on a simulated clock instead of POSIX timers.
+ * The clock jumps straight to the next timer ISR, which runs inline, so a
+ * G-code file piped to stdin prints much faster than real time, with the
+ * same steps at the same times on every run. The simulated print time is
+ * reported when stdin is closed and all moves are done.
+ */
+//#define LINUX_VIRTUAL_TIME
@@ -26,6 +26,10 @@
 
 HalSerial usb_serial;
 
+#if ENABLED(SERIAL_DMA)
+  volatile uint16_t SimRxDMA::count = RX_BUFFER_SIZE;
+#endif
+
 // U8glib required functions
 extern "C" void u8g_xMicroDelay(uint16_t val) {
   DELAY_US(val);
@@ -67,10 +71,13 @@ bool HAL_adc_finished() {
   return true;
 }
 
+// Analog pins hold 1/64 counts. Dither the fraction so oversampling sees it.
 uint16_t HAL_adc_get_result() {
   pin_t pin = analogInputToDigitalPin(active_ch);
   if (!VALID_PIN(pin)) return 0;
-  uint16_t data = ((Gpio::get(pin) >> 2) & 0x3FF);
+  static uint8_t dither;
+  dither = (dither + 37) & 0x3F;
+  const uint16_t data = _MIN((uint32_t(Gpio::get(pin)) + dither) >> 6, 0x3FFU);
   return data;    // return 10bit value as Marlin expects
 }
 
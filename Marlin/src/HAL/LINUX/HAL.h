@@ -79,6 +79,11 @@ extern HalSerial usb_serial;
 
 inline void HAL_init() {}
 
+#if EITHER(PLANNER_BENCHMARK, LINUX_VIRTUAL_TIME)
+  #define HAL_IDLETASK 1
+  void HAL_idletask();
+#endif
+
 // Utility functions
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-function"
@@ -67,7 +67,7 @@ bool digitalRead(pin_t pin) {
 
 void analogWrite(pin_t pin, int pwm_value) {  // 1 - 254: pwm_value, 0: LOW, 255: HIGH
   if (!VALID_PIN(pin)) return;
-  Gpio::set(pin, pwm_value);
+  Gpio::set(pin, pwm_value, true);
 }
 
 uint16_t analogRead(pin_t adc_pin) {
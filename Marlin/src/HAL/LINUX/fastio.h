@@ -39,6 +39,12 @@
 #define READ_PIN(IO)          Gpio::get(IO)
 #define WRITE_PIN(IO,V)       Gpio::set(IO, V)
 
+// Pins are grouped into 32-bit virtual ports for BATCHED_STEP_PULSES
+#define GPIO_PORT(IO)         Gpio::pin_port(IO)
+#define GPIO_PORT_MASK(IO)    Gpio::pin_mask(IO)
+#define WRITE_PORT_SET(P,M)   Gpio::set_port(P, M)
+#define WRITE_PORT_CLR(P,M)   Gpio::clear_port(P, M)
+
 /**
  * Magic I/O routines
  *
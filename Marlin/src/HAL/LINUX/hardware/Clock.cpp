@@ -28,4 +28,14 @@ std::chrono::nanoseconds Clock::startup = std::chrono::high_resolution_clock::no
 uint32_t Clock::frequency = F_CPU;
 double Clock::time_multiplier = 1.0;
 
+#if ENABLED(LINUX_VIRTUAL_TIME)
+
+  uint64_t Clock::virtual_nanos = 0;
+
+  void Clock::advance(uint64_t ns) {
+    HAL_timer_run_until(Clock::virtual_nanos + ns);
+  }
+
+#endif
+
 #endif // __PLAT_LINUX__
@@ -24,6 +24,8 @@
 #include <chrono>
 #include <thread>
 
+#include "../../../inc/MarlinConfigPre.h"
+
 class Clock {
 public:
   static uint64_t ticks(uint32_t frequency = Clock::frequency) {
@@ -45,8 +47,12 @@ public:
 
   // Time Acceleration compensated
   static uint64_t nanos() {
-    auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
-    return (now.count() - Clock::startup.count()) * Clock::time_multiplier;
+    #if ENABLED(LINUX_VIRTUAL_TIME)
+      return Clock::virtual_nanos;
+    #else
+      auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
+      return (now.count() - Clock::startup.count()) * Clock::time_multiplier;
+    #endif
   }
 
   static uint64_t micros() {
@@ -61,21 +67,40 @@ public:
     return Clock::nanos() / 1000000000.0;
   }
 
-  static void delayCycles(uint64_t cycles) {
-    std::this_thread::sleep_for(std::chrono::nanoseconds( (1000000000L / frequency) * cycles) / Clock::time_multiplier );
-  }
+  #if ENABLED(LINUX_VIRTUAL_TIME)
 
-  static void delayMicros(uint64_t micros) {
-    std::this_thread::sleep_for(std::chrono::microseconds( micros ) / Clock::time_multiplier);
-  }
+    // Delays move the simulated time on, running any timer ISRs that come due
+    static void delayCycles(uint64_t cycles) { advance(cycles * (1000000000ULL / frequency)); }
+    static void delayMicros(uint64_t micros) { advance(micros * 1000ULL); }
+    static void delayMillis(uint64_t millis) { advance(millis * 1000000ULL); }
+    static void delaySeconds(double secs)    { advance(secs * 1000000000.0); }
 
-  static void delayMillis(uint64_t millis) {
-    std::this_thread::sleep_for(std::chrono::milliseconds( millis ) / Clock::time_multiplier);
-  }
+    static void advance(uint64_t ns);
 
-  static void delaySeconds(double secs) {
-    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(secs * 1000) / Clock::time_multiplier);
-  }
+    // Set the simulated time directly (timer scheduler)
+    static void setNanos(uint64_t ns) {
+      Clock::virtual_nanos = ns;
+    }
+
+  #else
+
+    static void delayCycles(uint64_t cycles) {
+      std::this_thread::sleep_for(std::chrono::nanoseconds( (1000000000L / frequency) * cycles) / Clock::time_multiplier );
+    }
+
+    static void delayMicros(uint64_t micros) {
+      std::this_thread::sleep_for(std::chrono::microseconds( micros ) / Clock::time_multiplier);
+    }
+
+    static void delayMillis(uint64_t millis) {
+      std::this_thread::sleep_for(std::chrono::milliseconds( millis ) / Clock::time_multiplier);
+    }
+
+    static void delaySeconds(double secs) {
+      std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(secs * 1000) / Clock::time_multiplier);
+    }
+
+  #endif
 
   // Will reduce timer resolution increasing likelihood of overflows
   static void setTimeMultiplier(double tm) {
@@ -86,4 +111,7 @@ private:
   static std::chrono::nanoseconds startup;
   static uint32_t frequency;
   static double time_multiplier;
+  #if ENABLED(LINUX_VIRTUAL_TIME)
+    static uint64_t virtual_nanos;
+  #endif
 };
@@ -39,11 +39,13 @@ struct GpioEvent {
   uint64_t timestamp;
   pin_type pin_id;
   GpioEvent::Type event;
+  uint16_t value;   // The pin value, mode or direction after the event
 
-  GpioEvent(uint64_t timestamp, pin_type pin_id, GpioEvent::Type event){
+  GpioEvent(uint64_t timestamp, pin_type pin_id, GpioEvent::Type event, uint16_t value=0){
     this->timestamp = timestamp;
     this->pin_id = pin_id;
     this->event = event;
+    this->value = value;
   }
 };
 
@@ -81,11 +83,12 @@ public:
     set(pin, 1);
   }
 
-  static void set(pin_type pin, uint16_t value) {
+  // A digital write rises or falls. An analog (PWM) write always sets the value.
+  static void set(pin_type pin, uint16_t value, const bool analog=false) {
     if (!valid_pin(pin)) return;
-    GpioEvent::Type evt_type = value > 1 ? GpioEvent::SET_VALUE : value > pin_map[pin].value ? GpioEvent::RISE : value < pin_map[pin].value ? GpioEvent::FALL : GpioEvent::NOP;
+    GpioEvent::Type evt_type = analog ? GpioEvent::SET_VALUE : value > pin_map[pin].value ? GpioEvent::RISE : value < pin_map[pin].value ? GpioEvent::FALL : GpioEvent::NOP;
     pin_map[pin].value = value;
-    GpioEvent evt(Clock::nanos(), pin, evt_type);
+    GpioEvent evt(Clock::nanos(), pin, evt_type, value);
     if (pin_map[pin].cb != nullptr) {
       pin_map[pin].cb->interrupt(evt);
     }
@@ -101,10 +104,22 @@ public:
     set(pin, 0);
   }
 
+  // Pins are grouped into 32-pin ports, like LPC176x, so several can be written at once
+  static constexpr uint8_t pin_port(pin_type pin) { return pin >> 5; }
+  static constexpr uint32_t pin_mask(pin_type pin) { return 1UL << (pin & 0x1F); }
+
+  static void set_port(uint8_t port, uint32_t mask) {
+    for (uint8_t b = 0; mask; b++, mask >>= 1) if (mask & 1) set((port << 5) | b);
+  }
+
+  static void clear_port(uint8_t port, uint32_t mask) {
+    for (uint8_t b = 0; mask; b++, mask >>= 1) if (mask & 1) clear((port << 5) | b);
+  }
+
   static void setMode(pin_type pin, uint8_t value) {
     if (!valid_pin(pin)) return;
     pin_map[pin].mode = value;
-    GpioEvent evt(Clock::nanos(), pin, GpioEvent::Type::SETM);
+    GpioEvent evt(Clock::nanos(), pin, GpioEvent::Type::SETM, value);
     if (pin_map[pin].cb != nullptr) pin_map[pin].cb->interrupt(evt);
     if (Gpio::logger != nullptr) Gpio::logger->log(evt);
   }
@@ -117,7 +132,7 @@ public:
   static void setDir(pin_type pin, uint8_t value) {
     if (!valid_pin(pin)) return;
     pin_map[pin].dir = value;
-    GpioEvent evt(Clock::nanos(), pin, GpioEvent::Type::SETD);
+    GpioEvent evt(Clock::nanos(), pin, GpioEvent::Type::SETD, value);
     if (pin_map[pin].cb != nullptr) pin_map[pin].cb->interrupt(evt);
     if (Gpio::logger != nullptr) Gpio::logger->log(evt);
   }
@@ -23,38 +23,137 @@
 
 #include "Clock.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include "../../../inc/MarlinConfig.h"
+#include "../../../module/planner.h"
+#include "../../../module/temperature.h"
 
 #include "Heater.h"
 
-Heater::Heater(pin_t heater, pin_t adc) {
-  heater_state = 0;
-  room_temp_raw = 150;
-  last = Clock::micros();
-  heater_pin = heater;
-  adc_pin = adc;
-  heat = 0.0;
+ThermalModel ThermalModel::hotend() {
+  ThermalModel m = { 40, 16.7, 25, 0.068, 0.029, 0.0056, 0.22 };
+  m.configure("SIM_HOTEND");
+  return m;
+}
+
+ThermalModel ThermalModel::bed() {
+  ThermalModel m = { 200, 350, 25, 1.4, 0, 0, 0.3 };
+  m.configure("SIM_BED");
+  return m;
+}
+
+void ThermalModel::configure(const char * const env) {
+  static const struct { const char *key; double ThermalModel::*field; } fields[] = {
+    { "power", &ThermalModel::power },
+    { "capacity", &ThermalModel::capacity },
+    { "ambient", &ThermalModel::ambient },
+    { "ambient_xfer", &ThermalModel::ambient_xfer },
+    { "fan_xfer", &ThermalModel::fan_xfer },
+    { "filament_heat", &ThermalModel::filament_heat },
+    { "sensor_response", &ThermalModel::sensor_response }
+  };
+  const char *s = getenv(env);
+  if (!s) return;
+  char key[24];
+  double value;
+  int used;
+  while (sscanf(s, " %23[a-z_] = %lf%n", key, &value, &used) == 2) {
+    bool found = false;
+    for (auto &f : fields) if (!strcmp(key, f.key)) { this->*f.field = value; found = true; }
+    if (!found) fprintf(stderr, "%s: unknown key '%s'\n", env, key);
+    s += used;
+    while (*s == ',' || *s == ' ') s++;
+  }
+  if (*s) fprintf(stderr, "%s: can't parse '%s'\n", env, s);
+}
+
+void PwmMeter::set(const uint64_t now, const uint16_t value, const bool analog) {
+  high += level * (now - since);
+  since = now;
+  level = analog ? value / 255.0 : value ? 1 : 0;
+}
+
+double PwmMeter::read(const uint64_t now) {
+  const double duty = now > start ? (high + level * (now - since)) / (now - start) : level;
+  high = 0;
+  since = start = now;
+  return duty;
+}
+
+Heater::Heater(pin_t heater, pin_t adc, const ThermalModel &model, to_celsius_t to_celsius, pin_t fan/*=P_NC*/, const LinearAxis *extruder/*=nullptr*/)
+  : heater_pin(heater), adc_pin(adc), fan_pin(fan), model(model), to_celsius(to_celsius), extruder(extruder)
+{
+  block_temp = sensor_temp = model.ambient;
+  extruded = extruder ? extruder->position : 0;
+  last = Clock::nanos();
+  heater_pwm.since = heater_pwm.start = fan_pwm.since = fan_pwm.start = last;
+  Gpio::attachPeripheral(heater_pin, this);
+  if (fan_pin != P_NC) Gpio::attachPeripheral(fan_pin, this);
+  write_adc(); // Read room temperature until the first update
 }
 
 Heater::~Heater() {
 }
 
 void Heater::update() {
-  // crude pwm read and cruder heat simulation
-  auto now = Clock::micros();
-  double delta = (now - last);
-  if (delta > 1000 ) {
-    heater_state = pwmcap.update(0xFFFF * Gpio::pin_map[heater_pin].value);
-    last = now;
-    heat += (heater_state - heat) * (delta / 1000000000.0);
-
-    NOLESS(heat, room_temp_raw);
-    Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = 0xFFFF - (uint16_t)heat;
+  const uint64_t now = Clock::nanos();
+  if (now - last < 1000000) {
+    if (!settled) write_adc();      // Track the conversion as settings load
+    return;
   }
+  const double dt = (now - last) * 1e-9;
+  last = now;
+
+  const double heat = heater_pwm.read(now) * model.power,
+               fan = fan_pin != P_NC ? fan_pwm.read(now) : 0;
+
+  // Filament pushed past the furthest point so far is heated from room temperature
+  double feed = 0;
+  if (extruder && extruder->position > extruded) {
+    feed = (extruder->position - extruded) / planner.settings.axis_steps_per_mm[E_AXIS_N(0)] / dt;
+    extruded = extruder->position;
+  }
+
+  // Step in 10ms slices to keep the integration stable after long idles
+  for (double left = dt; left > 0; left -= 0.01) {
+    const double h = _MIN(left, 0.01),
+                 loss = (model.ambient_xfer + model.fan_xfer * fan + model.filament_heat * feed) * (block_temp - model.ambient);
+    block_temp += (heat - loss) / model.capacity * h;
+    sensor_temp += (block_temp - sensor_temp) * _MIN(model.sensor_response * h, 1.0);
+  }
+
+  write_adc();
+}
+
+/**
+ * Find the ADC reading for the sensor temperature through the firmware's
+ * own conversion, interpolated to 1/64 count. HAL_adc_get_result dithers
+ * the fraction so oversampling sees it.
+ */
+void Heater::write_adc() {
+  int lo = 0, hi = HAL_ADC_RANGE - 1;
+  // A flat conversion (e.g. a user thermistor before settings load) can't be inverted
+  settled = to_celsius(hi * (OVERSAMPLENR)) != to_celsius(lo);
+  if (!settled) {
+    Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = HAL_ADC_RANGE / 2 * 64;
+    return;
+  }
+  const bool rising = to_celsius(hi * (OVERSAMPLENR)) > to_celsius(lo);  // The sensor can change with settings
+  auto past = [&](const int adc) { return (to_celsius(adc * (OVERSAMPLENR)) > sensor_temp) == rising; };
+  if (past(lo)) hi = lo;
+  else if (!past(hi)) lo = hi;
+  else while (hi - lo > 1) { const int m = (lo + hi) / 2; if (past(m)) hi = m; else lo = m; }
+
+  const double c0 = to_celsius(lo * (OVERSAMPLENR)), c1 = to_celsius(hi * (OVERSAMPLENR)),
+               adc = hi > lo && c1 != c0 ? lo + constrain((sensor_temp - c0) / (c1 - c0), 0.0, 1.0) : lo;
+  Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = uint16_t(adc * 64);
 }
 
 void Heater::interrupt(GpioEvent ev) {
-  // ununsed
+  if (ev.event == GpioEvent::SETM || ev.event == GpioEvent::SETD) return;
+  const bool analog = ev.event == GpioEvent::SET_VALUE;   // analogWrite, else a digital write
+  if (ev.pin_id == heater_pin) heater_pwm.set(ev.timestamp, ev.value, analog);
+  else if (ev.pin_id == fan_pin) fan_pwm.set(ev.timestamp, ev.value, analog);
 }
 
 #endif // __PLAT_LINUX__
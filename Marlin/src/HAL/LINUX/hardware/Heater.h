@@ -22,26 +22,61 @@
 #pragma once
 
 #include "Gpio.h"
+#include "LinearAxis.h"
 
-struct LowpassFilter {
-  uint64_t data_delay = 0;
-  uint16_t update(uint16_t value) {
-    data_delay = data_delay - (data_delay >> 6) + value;
-    return (uint16_t)(data_delay >> 6);
-  }
+/**
+ * Lumped thermal model of a heater block and its sensor:
+ *
+ *   capacity * dT/dt = power * duty - (ambient_xfer + fan_xfer * fan) * (T - ambient)
+ *                      - filament_heat * (mm/s extruded) * (T - ambient)
+ *   dS/dt = sensor_response * (T - S)
+ *
+ * Defaults suit a 40W cartridge in a V6-style block and a 200W bed. Any of
+ * them can be set at run time with "key=value" pairs in the environment,
+ * e.g. SIM_HOTEND="power=50 capacity=20" or SIM_BED="ambient_xfer=2.5".
+ */
+struct ThermalModel {
+  double power,            // Heater power at full duty (W)
+         capacity,         // Heat capacity of the block (J/K)
+         ambient,          // Room temperature (C)
+         ambient_xfer,     // Heat loss to the room, fan off (W/K)
+         fan_xfer,         // Added heat loss with the part fan at full speed (W/K)
+         filament_heat,    // Heat capacity of each mm of filament (J/K/mm)
+         sensor_response;  // Part of the block-to-sensor difference closed per second (1/s)
+
+  static ThermalModel hotend();  // Defaults, then SIM_HOTEND
+  static ThermalModel bed();     // Defaults, then SIM_BED
+  void configure(const char * const env);
+};
+
+// Average duty of a digital or analogWrite pin between reads
+struct PwmMeter {
+  double level = 0, high = 0;
+  uint64_t since = 0, start = 0;
+  void set(const uint64_t now, const uint16_t value, const bool analog);
+  double read(const uint64_t now);
 };
 
 class Heater: public Peripheral {
 public:
-  Heater(pin_t heater, pin_t adc);
+  typedef float (*to_celsius_t)(const int raw);
+
+  Heater(pin_t heater, pin_t adc, const ThermalModel &model, to_celsius_t to_celsius, pin_t fan=P_NC, const LinearAxis *extruder=nullptr);
   virtual ~Heater();
   void interrupt(GpioEvent ev);
   void update();
 
-  pin_t heater_pin, adc_pin;
-  uint16_t room_temp_raw;
-  uint16_t heater_state;
-  LowpassFilter pwmcap;
-  double heat;
+  pin_t heater_pin, adc_pin, fan_pin;
+  ThermalModel model;
+  double block_temp, sensor_temp;   // C
+
+private:
+  void write_adc();
+
+  to_celsius_t to_celsius;
+  const LinearAxis *extruder;
+  int32_t extruded;                 // Furthest extruder position, so retracts don't count twice
+  PwmMeter heater_pwm, fan_pwm;
   uint64_t last;
+  bool settled;                     // The firmware conversion gave a usable curve
 };
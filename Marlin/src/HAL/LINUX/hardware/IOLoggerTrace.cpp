@@ -0,0 +1,176 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "IOLoggerTrace.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+static const uint8_t trace_magic[8] = { 'M', 'R', 'L', 'N', 'T', 'R', 'C', 2 };
+#define TRACE_HEADER_SIZE 24
+
+static uint8_t put_varint(uint8_t *buf, uint64_t v) {
+  uint8_t n = 0;
+  for (; v >= 0x80; v >>= 7) buf[n++] = uint8_t(v) | 0x80;
+  buf[n++] = uint8_t(v);
+  return n;
+}
+
+IOLoggerTrace::IOLoggerTrace(const char *filename) : rings_used(0), dropped_events(0) {
+  for (Ring &r : rings) r.head = r.tail = 0;
+  last_timestamp = 0;
+  map = nullptr;
+  map_offset = map_used = file_size = 0;
+  fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0 || !map_window(0)) {
+    fprintf(stderr, "IOLoggerTrace: can't write %s\n", filename);
+    return;
+  }
+  const uint64_t header[2] = { 0, 0 };
+  write(trace_magic, sizeof(trace_magic));
+  write((const uint8_t*)header, sizeof(header));
+}
+
+IOLoggerTrace::~IOLoggerTrace() {
+  flush();
+  if (map) munmap(map, map_size);
+  if (fd >= 0) {
+    // Cut the file down to the records written
+    if (ftruncate(fd, map_offset + map_used) < 0) perror("IOLoggerTrace");
+    close(fd);
+  }
+  if (dropped()) fprintf(stderr, "IOLoggerTrace: %lu events dropped\n", (unsigned long)dropped());
+}
+
+/**
+ * Producer: put the event in the ring of this context, or drop it if the
+ * ring is full. The rings are claimed on first use, which is safe in a
+ * signal handler. There is one trace per process, so the thread's rings
+ * don't need to know which trace they belong to.
+ */
+void IOLoggerTrace::log(GpioEvent ev) {
+  static thread_local Ring *own[max_depth];
+  static thread_local uint8_t depth = 0;
+  if (depth == max_depth) { dropped_events++; return; }
+  const uint8_t d = depth++;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+
+  Ring *r = own[d];
+  if (!r) {
+    uint8_t i = rings_used.load(std::memory_order_relaxed);
+    while (i < max_rings && !rings_used.compare_exchange_weak(i, i + 1)) { /* another producer claimed ring i */ }
+    if (i < max_rings) r = own[d] = &rings[i];
+  }
+
+  const size_t h = r ? r->head.load(std::memory_order_relaxed) : 0;
+  if (!r || h - r->tail.load(std::memory_order_acquire) == ring_size)
+    dropped_events++;
+  else {
+    r->events[h & (ring_size - 1)] = { ev.timestamp, ev.value, uint8_t(ev.pin_id), uint8_t(ev.event) };
+    r->head.store(h + 1, std::memory_order_release);
+  }
+
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  depth--;
+}
+
+size_t IOLoggerTrace::pending() {
+  size_t most = 0;
+  for (uint8_t i = 0; i < rings_used.load(std::memory_order_acquire); i++)
+    NOLESS(most, rings[i].head.load(std::memory_order_acquire) - rings[i].tail.load(std::memory_order_relaxed));
+  return most;
+}
+
+// Consumer: merge the rings by timestamp into the file
+void IOLoggerTrace::flush() {
+  const uint8_t n = rings_used.load(std::memory_order_acquire);
+  size_t head[max_rings], tail[max_rings];
+  for (uint8_t i = 0; i < n; i++) {
+    tail[i] = rings[i].tail.load(std::memory_order_relaxed);
+    head[i] = rings[i].head.load(std::memory_order_acquire);
+  }
+
+  bool wrote = false;
+  for (;;) {
+    // The earliest event at the tail of a ring
+    const Record *e = nullptr;
+    uint8_t from = 0;
+    for (uint8_t i = 0; i < n; i++) if (tail[i] != head[i]) {
+      const Record &t = rings[i].events[tail[i] & (ring_size - 1)];
+      if (!e || t.timestamp < e->timestamp) { e = &t; from = i; }
+    }
+    if (!e) break;
+
+    uint8_t rec[24], len;
+    const int64_t delta = int64_t(e->timestamp - last_timestamp);
+    len = put_varint(rec, (uint64_t(delta) << 1) ^ uint64_t(delta >> 63));
+    rec[len++] = e->pin;
+    rec[len++] = e->event;
+    if (e->event >= GpioEvent::SET_VALUE) len += put_varint(rec + len, e->value);
+    write(rec, len);
+    last_timestamp = e->timestamp;
+    tail[from]++;
+    wrote = true;
+  }
+
+  for (uint8_t i = 0; i < n; i++) rings[i].tail.store(tail[i], std::memory_order_release);
+  if (wrote || dropped()) write_header();
+}
+
+// Let readers know how much of the file holds records, even if the program is killed
+void IOLoggerTrace::write_header() {
+  if (!map) return;
+  const uint64_t header[2] = { map_offset + map_used - TRACE_HEADER_SIZE, dropped() };
+  if (pwrite(fd, header, sizeof(header), sizeof(trace_magic)) < 0) perror("IOLoggerTrace");
+}
+
+void IOLoggerTrace::write(const uint8_t *data, size_t len) {
+  while (len && map) {
+    if (map_used == map_size && !map_window(map_offset + map_size)) return;
+    const size_t chunk = _MIN(len, map_size - map_used);
+    memcpy(map + map_used, data, chunk);
+    map_used += chunk;
+    data += chunk;
+    len -= chunk;
+  }
+}
+
+// Grow the file and map the window starting at the given offset
+bool IOLoggerTrace::map_window(size_t offset) {
+  if (map) { munmap(map, map_size); map = nullptr; }
+  if (offset + map_size > file_size) {
+    if (ftruncate(fd, offset + map_size) < 0) return false;
+    file_size = offset + map_size;
+  }
+  void * const m = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+  if (m == MAP_FAILED) return false;
+  map = (uint8_t*)m;
+  map_offset = offset;
+  map_used = 0;
+  return true;
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,95 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Binary GPIO trace, written to a memory-mapped file
+ *
+ * Events come from several producers: the Marlin threads, and the timer
+ * signal handlers that interrupt them. Each producer context gets its own
+ * single-producer ring, so log() never waits and never shares a ring. A
+ * signal handler that runs while its thread is in log() takes the thread's
+ * next ring. There is one consumer, the thread that calls flush(). It merges
+ * the rings by timestamp and encodes the records into the file.
+ *
+ * An event is dropped only if its ring is full or no ring is left. Drops are
+ * counted in the file header, and reported on exit and by the decoder.
+ *
+ * File format (decode with buildroot/share/scripts/decodeStepTrace.py):
+ *   Header:  "MRLNTRC" followed by the format version byte (2)
+ *            uint64    bytes of records that follow, updated on each flush()
+ *            uint64    events dropped so far, updated on each flush()
+ *   Records: varint    time since the previous record in ns (zigzag signed)
+ *            uint8     pin
+ *            uint8     GpioEvent::Type
+ *            varint    value, only for SET_VALUE, SETM and SETD
+ * Varints are LEB128: 7 bits per byte, low bits first, high bit set on all but the last.
+ * Records are in time order within each flush(). An event logged after a
+ * flush() that wrote later events has a negative time delta.
+ */
+
+#include <atomic>
+#include "Gpio.h"
+
+class IOLoggerTrace: public IOLogger {
+public:
+  static constexpr size_t ring_size = 1UL << 15,      // Events in each ring, power of 2
+                          map_size  = 16UL << 20;     // File window mapped at once
+  static constexpr uint8_t max_rings = 16,            // Producer contexts in the process
+                           max_depth = 3;             // A thread, and signal handlers nested in it
+
+  IOLoggerTrace(const char *filename);
+  virtual ~IOLoggerTrace();
+  void flush();
+  void log(GpioEvent ev);
+
+  uint64_t dropped() { return dropped_events.load(std::memory_order_relaxed); }
+
+  // Events waiting for flush() in the fullest ring
+  size_t pending();
+
+private:
+  struct Record { uint64_t timestamp; uint16_t value; uint8_t pin, event; };
+
+  // Single-producer ring. Indexes are free-running, head written by the
+  // producer and tail by the consumer.
+  struct Ring {
+    Record events[ring_size];
+    std::atomic<size_t> head, tail;
+  };
+
+  void write(const uint8_t *data, size_t len);
+  bool map_window(size_t offset);
+  void write_header();
+
+  Ring rings[max_rings];
+  std::atomic<uint8_t> rings_used;    // Rings claimed by producers
+  std::atomic<uint64_t> dropped_events;
+  uint64_t last_timestamp;            // Of the last record written, for the consumer
+
+  // Output file
+  int fd;
+  uint8_t *map;
+  size_t map_offset,  // File offset of the mapped window
+         map_used,    // Bytes written into the window
+         file_size;
+};
@@ -74,6 +74,22 @@ private:
   volatile uint32_t index_read;
 };
 
+#if ENABLED(SERIAL_DMA)
+
+  #include "../../shared/DMARxRing.h"
+
+  /**
+   * A stand-in for a circular RX DMA channel. The host side stores bytes
+   * with rx_write(), as the UART and DMA would, scanning at each half of
+   * the buffer like the DMA interrupts, and calls rx_idle() when it pauses.
+   */
+  struct SimRxDMA {
+    static volatile uint16_t count;   // Transfers left before the buffer wraps
+    static uint16_t remaining() { return count; }
+  };
+
+#endif
+
 class HalSerial {
 public:
 
@@ -87,12 +103,49 @@ public:
 
   void end() {}
 
-  int peek() {
-    uint8_t value;
-    return receive_buffer.peek(&value) ? value : -1;
-  }
+  #if ENABLED(SERIAL_DMA)
+
+    DMARxRing<RX_BUFFER_SIZE, SimRxDMA::remaining> rx_dma;
+
+    int peek() { return rx_dma.peek(); }
+    int read() { return rx_dma.read(); }
+    uint16_t available() { return rx_dma.available(); }
+    void flush() { rx_dma.flush(); }
+
+    // The host side
+    uint32_t rx_free() { return RX_BUFFER_SIZE - 1 - rx_dma.available(); }
+    void rx_write(const uint8_t c) {
+      rx_dma.buffer[RX_BUFFER_SIZE - SimRxDMA::count] = c;
+      SimRxDMA::count = SimRxDMA::count > 1 ? SimRxDMA::count - 1 : RX_BUFFER_SIZE;
+      if (SimRxDMA::count == RX_BUFFER_SIZE || SimRxDMA::count == RX_BUFFER_SIZE / 2) rx_idle();
+    }
+    void rx_idle() {
+      #if ENABLED(EMERGENCY_PARSER)
+        rx_dma.scan([this](const uint8_t c) { emergency_parser.update(emergency_state, c); });
+      #endif
+    }
+
+  #else
 
-  int read() { return receive_buffer.read(); }
+    int peek() {
+      uint8_t value;
+      return receive_buffer.peek(&value) ? value : -1;
+    }
+
+    int read() { return receive_buffer.read(); }
+
+    uint16_t available() {
+      return (uint16_t)receive_buffer.available();
+    }
+
+    void flush() { receive_buffer.clear(); }
+
+    // The host side
+    uint32_t rx_free() { return receive_buffer.free(); }
+    void rx_write(const uint8_t c) { receive_buffer.write(c); }
+    void rx_idle() {}
+
+  #endif
 
   size_t write(char c) {
     if (!host_connected) return 0;
@@ -102,12 +155,6 @@ public:
 
   operator bool() { return host_connected; }
 
-  uint16_t available() {
-    return (uint16_t)receive_buffer.available();
-  }
-
-  void flush() { receive_buffer.clear(); }
-
   uint8_t availableForWrite() {
     return transmit_buffer.free() > 255 ? 255 : (uint8_t)transmit_buffer.free();
   }
@@ -202,7 +249,9 @@ public:
   void println(double value, int round = 6) { printf("%f\n" , value); }
   void println() { print('\n'); }
 
-  volatile RingBuffer<uint8_t, 128> receive_buffer;
+  #if DISABLED(SERIAL_DMA)
+    volatile RingBuffer<uint8_t, 128> receive_buffer;
+  #endif
   volatile RingBuffer<uint8_t, 128> transmit_buffer;
   volatile bool host_connected;
 };
@@ -31,10 +31,25 @@ extern void loop();
 #include <stdio.h>
 #include <stdarg.h>
 #include "../shared/Delay.h"
-#include "hardware/IOLoggerCSV.h"
+#include "hardware/IOLoggerTrace.h"
 #include "hardware/Heater.h"
 #include "hardware/LinearAxis.h"
 
+#include "../../module/temperature.h"
+
+#if ENABLED(PLANNER_BENCHMARK)
+  #include "../../feature/planner_benchmark.h"
+#elif ENABLED(LINUX_VIRTUAL_TIME)
+  #include "../../gcode/queue.h"
+  #include "../../module/planner.h"
+#endif
+
+//#define GPIO_LOGGING // Full GPIO trace and position logging
+
+#ifdef GPIO_LOGGING
+  static IOLoggerTrace gpio_trace("gpio_trace.bin");
+#endif
+
 // simple stdout / stdin implementation for fake serial port
 void write_serial_thread() {
   for (;;) {
@@ -48,27 +63,54 @@ void write_serial_thread() {
 void read_serial_thread() {
   char buffer[255] = {};
   for (;;) {
-    std::size_t len = _MIN(usb_serial.receive_buffer.free(), 254U);
-    if (fgets(buffer, len, stdin))
+    std::size_t len = _MIN(usb_serial.rx_free(), 254U);
+    if (len > 1 && fgets(buffer, len, stdin)) {
       for (std::size_t i = 0; i < strlen(buffer); i++)
-        usb_serial.receive_buffer.write(buffer[i]);
+        usb_serial.rx_write(buffer[i]);
+      usb_serial.rx_idle();
+    }
     std::this_thread::yield();
   }
 }
 
+/**
+ * Sensor readings for the thermal models, through the firmware's own conversion.
+ * This may run on its own thread, so a user thermistor goes through the formula,
+ * which only reads the settings. Until the firmware has done its pre-calculation
+ * the conversion is flat, and the heater waits for it.
+ */
+#if HAS_USER_THERMISTORS
+  static float user_celsius(const uint8_t t_index, const int raw) {
+    return thermalManager.user_thermistor[t_index].pre_calc ? 25 : thermalManager.user_thermistor_formula(t_index, raw);
+  }
+#endif
+
+static float hotend_celsius(const int raw) {
+  #if ENABLED(HEATER_0_USER_THERMISTOR)
+    return user_celsius(CTI_HOTEND_0, raw);
+  #else
+    return TERN(HAS_HOTEND, thermalManager.analog_to_celsius_hotend(raw, 0), 25);
+  #endif
+}
+
+static float bed_celsius(const int raw) {
+  #if ENABLED(HEATER_BED_USER_THERMISTOR)
+    return user_celsius(CTI_BED, raw);
+  #else
+    return TERN(HAS_HEATED_BED, thermalManager.analog_to_celsius_bed(raw), 25);
+  #endif
+}
+
 void simulation_loop() {
-  Heater hotend(HEATER_0_PIN, TEMP_0_PIN);
-  Heater bed(HEATER_BED_PIN, TEMP_BED_PIN);
   LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
   LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
   LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
   LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
-
-  //#define GPIO_LOGGING // Full GPIO and Positional Logging
+  Heater hotend(HEATER_0_PIN, TEMP_0_PIN, ThermalModel::hotend(), hotend_celsius, FAN_PIN, &extruder0);
+  Heater bed(HEATER_BED_PIN, TEMP_BED_PIN, ThermalModel::bed(), bed_celsius);
 
   #ifdef GPIO_LOGGING
-    IOLoggerCSV logger("all_gpio_log.csv");
-    Gpio::attachLogger(&logger);
+    Gpio::attachLogger(&gpio_trace);
 
     std::ofstream position_log;
     position_log.open("axis_position_log.csv");
@@ -88,7 +130,7 @@ void simulation_loop() {
 
     #ifdef GPIO_LOGGING
       if (x_axis.position != x || y_axis.position != y || z_axis.position != z) {
-        uint64_t update = MAX3(x_axis.last_update, y_axis.last_update, z_axis.last_update);
+        uint64_t update = _MAX(x_axis.last_update, y_axis.last_update, z_axis.last_update);
         position_log << update << ", " << x_axis.position << ", " << y_axis.position << ", " << z_axis.position << std::endl;
         position_log.flush();
         x = x_axis.position;
@@ -96,13 +138,184 @@ void simulation_loop() {
         z = z_axis.position;
       }
       // flush the logger
-      logger.flush();
+      gpio_trace.flush();
     #endif
 
     std::this_thread::yield();
   }
 }
 
+#if ENABLED(PLANNER_BENCHMARK)
+
+// Replay the G-code files named on the command line as fast as possible
+int main(int argc, char *argv[]) {
+  std::thread write_serial (write_serial_thread);
+  write_serial.detach();
+
+  MYSERIAL0.begin(BAUDRATE);
+  Clock::setFrequency(F_CPU);
+  HAL_timer_init();
+
+  setup();
+  SERIAL_FLUSHTX();
+
+  return PlannerBenchmark::run(argc - 1, argv + 1);
+}
+
+#elif ENABLED(LINUX_VIRTUAL_TIME)
+
+/**
+ * Virtual time runs the whole machine in the main thread. Each time Marlin
+ * idles, the host sends the next line from stdin if the last one was taken,
+ * the simulated hardware is updated, and the Clock jumps to the next timer
+ * ISR. Once stdin is closed and all commands and moves are done, the
+ * simulated time is reported and the program exits.
+ */
+static std::chrono::steady_clock::time_point wall_start;
+
+static void update_simulation() {
+  static LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
+  static LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
+  static LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
+  static LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
+  static Heater hotend(HEATER_0_PIN, TEMP_0_PIN, ThermalModel::hotend(), hotend_celsius, FAN_PIN, &extruder0);
+  static Heater bed(HEATER_BED_PIN, TEMP_BED_PIN, ThermalModel::bed(), bed_celsius);
+
+  hotend.update();
+  bed.update();
+
+  x_axis.update();
+  y_axis.update();
+  z_axis.update();
+  extruder0.update();
+
+  #ifdef GPIO_LOGGING
+    // Flush in large batches. The rest is written out on exit.
+    if (gpio_trace.pending() > IOLoggerTrace::ring_size / 2) gpio_trace.flush();
+  #endif
+}
+
+void HAL_idletask() {
+  static bool host_done = false;
+
+  if (!host_done && !usb_serial.available()) {
+    char buffer[128];
+    if (fgets(buffer, sizeof(buffer), stdin)) {
+      for (char *c = buffer; *c; c++) usb_serial.rx_write(*c);
+      usb_serial.rx_idle();
+    }
+    else
+      host_done = true;
+  }
+  else if (host_done && !queue.has_commands_queued() && !planner.has_blocks_queued()) {
+    const auto wall = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - wall_start);
+    SERIAL_ECHO_START();
+    SERIAL_ECHOLNPAIR("Simulated time: ", uint32_t(Clock::millis()), "ms  real time: ", uint32_t(wall.count()), "ms");
+    SERIAL_FLUSHTX();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // Let the serial thread write it out
+    exit(0);
+  }
+
+  update_simulation();
+
+  const uint64_t next = HAL_timer_next_event();
+  HAL_timer_run_until(next != UINT64_MAX ? next : Clock::nanos() + 1000000ULL);
+}
+
+#if ENABLED(SERIAL_DMA)
+
+/**
+ * Check the DMA ring through the host side before Marlin starts. Data must
+ * come back in order over several wraps. With EMERGENCY_PARSER an M112 must
+ * be found by the half buffer scan, by the full buffer scan and the idle scan
+ * when it's split across the wrap, and not after a flush().
+ */
+static bool check_serial_dma() {
+  constexpr uint16_t S = RX_BUFFER_SIZE;
+  HalSerial &ser = usb_serial;
+  bool ok = true;
+  auto fail = [&](const char * const what) { SERIAL_ECHOLNPAIR("SERIAL_DMA check failed: ", what); ok = false; };
+  auto put = [&](const char * const str) { for (const char *c = str; *c; c++) ser.rx_write(*c); };
+  auto move_to = [&](const uint16_t count) { while (SimRxDMA::count != count) ser.rx_write(' '); };
+
+  // Data over three wraps, read back in chunks
+  ser.flush();
+  for (uint16_t i = 0; i < 3 * S; i += 100) {
+    LOOP_L_N(j, 100) ser.rx_write(uint8_t(i + j));
+    if (ser.available() != 100 || ser.peek() != uint8_t(i)) { fail("available / peek"); break; }
+    LOOP_L_N(j, 100) if (ser.read() != uint8_t(i + j)) { fail("read"); break; }
+    if (ser.read() != -1) { fail("empty read"); break; }
+  }
+
+  #if ENABLED(EMERGENCY_PARSER)
+    bool &killed = EmergencyParser::killed_by_M112;
+
+    // Ends just before the half buffer scan
+    ser.flush();
+    ser.emergency_state = EmergencyParser::EP_RESET; // Forget the binary data
+    move_to(S / 2 + 8);
+    put("M112\n");
+    if (killed) fail("scan before half buffer");
+    put("   ");
+    if (!killed) fail("half buffer scan");
+    killed = false;
+
+    // Split across the wrap. The full buffer scan sees "M1", the idle scan the rest.
+    ser.flush();
+    move_to(2);
+    put("M1");
+    put("12\n");
+    if (killed) fail("scan before idle");
+    ser.rx_idle();
+    if (!killed) fail("idle scan across the wrap");
+    killed = false;
+
+    // Dropped input isn't scanned
+    put("M112\n");
+    ser.flush();
+    ser.rx_idle();
+    if (killed) fail("scan after flush");
+    killed = false;
+    ser.emergency_state = EmergencyParser::EP_RESET;
+  #endif
+
+  ser.flush();
+  return ok;
+}
+
+#endif
+
+int main() {
+  std::thread write_serial (write_serial_thread);
+  write_serial.detach();
+
+  MYSERIAL0.begin(BAUDRATE);
+  SERIAL_ECHOLNPGM("x86_64 Initialized");
+  SERIAL_FLUSHTX();
+
+  #if ENABLED(SERIAL_DMA)
+    if (!check_serial_dma()) {
+      SERIAL_FLUSHTX();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10)); // Let the serial thread write it out
+      return 1;
+    }
+  #endif
+
+  wall_start = std::chrono::steady_clock::now();
+  Clock::setFrequency(F_CPU);
+  HAL_timer_init();
+
+  #ifdef GPIO_LOGGING
+    Gpio::attachLogger(&gpio_trace);
+  #endif
+  update_simulation(); // Attach the simulated hardware before anything moves
+
+  setup();
+  for (;;) loop();
+}
+
+#else
+
 int main() {
   std::thread write_serial (write_serial_thread);
   std::thread read_serial (read_serial_thread);
@@ -133,4 +346,6 @@ int main() {
   read_serial.join();
 }
 
+#endif
+
 #endif // __PLAT_LINUX__
@@ -33,39 +33,182 @@
 HAL_STEP_TIMER_ISR();
 HAL_TEMP_TIMER_ISR();
 
-Timer timers[2];
+#if ENABLED(PLANNER_BENCHMARK)
 
-void HAL_timer_init() {
-  timers[0].init(0, STEPPER_TIMER_RATE, TIMER0_IRQHandler);
-  timers[1].init(1, TEMP_TIMER_RATE, TIMER1_IRQHandler);
-}
+  #include "../../module/planner.h"
+  #include "../../feature/planner_benchmark.h"
+  #if ENABLED(STEP_SEGMENT_QUEUE)
+    #include "../../feature/step_segments.h"
+  #endif
 
-void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency) {
-  timers[timer_num].start(frequency);
-}
+  /**
+   * The benchmark never arms the POSIX timers. Compare values are only
+   * stored, and the count advances on every read so that timed pulse waits
+   * in the stepper ISR always terminate. The stepper ISR is run inline by
+   * HAL_idletask() whenever the planner waits for a free block, with the
+   * segment compiler (STEP_SEGMENT_QUEUE) run before each call, unless
+   * the benchmark is starving it.
+   */
+  static hal_timer_t timer_compare[2], timer_count[2];
+  static bool timer_enabled[2];
 
-void HAL_timer_enable_interrupt(const uint8_t timer_num) {
-  timers[timer_num].enable();
-}
+  void HAL_timer_init() {}
+  void HAL_timer_start(const uint8_t, const uint32_t) {}
 
-void HAL_timer_disable_interrupt(const uint8_t timer_num) {
-  timers[timer_num].disable();
-}
+  void HAL_timer_enable_interrupt(const uint8_t timer_num) { timer_enabled[timer_num] = true; }
+  void HAL_timer_disable_interrupt(const uint8_t timer_num) { timer_enabled[timer_num] = false; }
+  bool HAL_timer_interrupt_enabled(const uint8_t timer_num) { return timer_enabled[timer_num]; }
 
-bool HAL_timer_interrupt_enabled(const uint8_t timer_num) {
-  return timers[timer_num].enabled();
-}
+  void HAL_timer_set_compare(const uint8_t timer_num, const hal_timer_t compare) { timer_compare[timer_num] = compare; }
+  hal_timer_t HAL_timer_get_compare(const uint8_t timer_num) { return timer_compare[timer_num]; }
+  hal_timer_t HAL_timer_get_count(const uint8_t timer_num) { return timer_count[timer_num]++; }
 
-void HAL_timer_set_compare(const uint8_t timer_num, const hal_timer_t compare) {
-  timers[timer_num].setCompare(compare);
-}
+  // Run the stepper ISR until the oldest block is released or the planner is empty
+  void HAL_idletask() {
+    if (!timer_enabled[STEP_TIMER_NUM]) return;
+    const uint8_t tail = planner.block_buffer_tail;
+    while (planner.has_blocks_queued() && tail == planner.block_buffer_tail) {
+      #if ENABLED(STEP_SEGMENT_QUEUE)
+        if (!PlannerBenchmark::compiler_starved()) step_segments.compile();
+      #endif
+      timer_count[STEP_TIMER_NUM] = 0;
+      {
+        BENCH_SCOPE(STEPPER_ISR);
+        TIMER0_IRQHandler();
+      }
+      PlannerBenchmark::record_step_interval(timer_compare[STEP_TIMER_NUM]);
+    }
+  }
 
-hal_timer_t HAL_timer_get_compare(const uint8_t timer_num) {
-  return timers[timer_num].getCompare();
-}
+#elif ENABLED(LINUX_VIRTUAL_TIME)
 
-hal_timer_t HAL_timer_get_count(const uint8_t timer_num) {
-  return timers[timer_num].getCount();
-}
+  /**
+   * Nothing runs on its own in virtual time. Each timer keeps the simulated
+   * time of its next compare match, and the Clock jumps from one match to
+   * the next with the ISR run inline, so every run of the same input gives
+   * the same steps at the same times.
+   *
+   * The timers reset on a compare match, as on the LPC1768, and keep counting
+   * while their interrupt is disabled. Each read of the count takes one timer
+   * tick, so timed pulse waits in the ISRs terminate. ISRs never nest: time
+   * moved on inside an ISR only makes the other timer late.
+   */
+  typedef struct {
+    bool enabled;
+    hal_timer_t compare;
+    uint32_t frequency;
+    uint64_t start,       // Simulated time of the last compare match
+             period;      // Nanoseconds to the next one
+    void (*isr)();
+  } virtual_timer_t;
+
+  static virtual_timer_t timers[2];
+  static bool in_isr;
+
+  static void set_period(virtual_timer_t &t) {
+    t.period = _MAX(Clock::ticksToNanos(t.compare, t.frequency), Clock::ticksToNanos(1, t.frequency));
+  }
+
+  void HAL_timer_init() {
+    timers[STEP_TIMER_NUM] = { false, HAL_TIMER_TYPE_MAX, STEPPER_TIMER_RATE, 0, 0, TIMER0_IRQHandler };
+    timers[TEMP_TIMER_NUM] = { false, HAL_TIMER_TYPE_MAX, TEMP_TIMER_RATE, 0, 0, TIMER1_IRQHandler };
+    LOOP_L_N(i, COUNT(timers)) set_period(timers[i]);
+  }
+
+  void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency) {
+    virtual_timer_t &t = timers[timer_num];
+    t.start = Clock::nanos();
+    t.compare = t.frequency / frequency;
+    set_period(t);
+  }
+
+  void HAL_timer_enable_interrupt(const uint8_t timer_num) { timers[timer_num].enabled = true; }
+  void HAL_timer_disable_interrupt(const uint8_t timer_num) { timers[timer_num].enabled = false; }
+  bool HAL_timer_interrupt_enabled(const uint8_t timer_num) { return timers[timer_num].enabled; }
+
+  void HAL_timer_set_compare(const uint8_t timer_num, const hal_timer_t compare) {
+    timers[timer_num].compare = compare;
+    set_period(timers[timer_num]);
+  }
+  hal_timer_t HAL_timer_get_compare(const uint8_t timer_num) { return timers[timer_num].compare; }
+
+  hal_timer_t HAL_timer_get_count(const uint8_t timer_num) {
+    const virtual_timer_t &t = timers[timer_num];
+    Clock::setNanos(Clock::nanos() + Clock::ticksToNanos(1, t.frequency));
+    return Clock::nanosToTicks(Clock::nanos() - t.start, t.frequency);
+  }
+
+  uint64_t HAL_timer_next_event() {
+    uint64_t next = UINT64_MAX;
+    for (const virtual_timer_t &t : timers)
+      if (t.enabled) NOMORE(next, t.start + t.period);
+    return next;
+  }
+
+  void HAL_timer_run_until(const uint64_t ns) {
+    if (!in_isr) for (;;) {
+      // The timer with the earliest compare match. Ties go to the stepper.
+      virtual_timer_t *next = nullptr;
+      for (virtual_timer_t &t : timers)
+        if (t.enabled && (!next || t.start + t.period < next->start + next->period)) next = &t;
+      if (!next) break;
+
+      const uint64_t due = next->start + next->period;
+      if (due > ns) break;
+
+      // A late timer has kept counting, resetting on every compare match
+      const uint64_t now = Clock::nanos();
+      if (due > now) {
+        Clock::setNanos(due);
+        next->start = due;
+      }
+      else
+        next->start = now - (now - next->start) % next->period;
+
+      in_isr = true;
+      next->isr();
+      in_isr = false;
+    }
+    if (ns > Clock::nanos()) Clock::setNanos(ns);
+  }
+
+#else
+
+  Timer timers[2];
+
+  void HAL_timer_init() {
+    timers[0].init(0, STEPPER_TIMER_RATE, TIMER0_IRQHandler);
+    timers[1].init(1, TEMP_TIMER_RATE, TIMER1_IRQHandler);
+  }
+
+  void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency) {
+    timers[timer_num].start(frequency);
+  }
+
+  void HAL_timer_enable_interrupt(const uint8_t timer_num) {
+    timers[timer_num].enable();
+  }
+
+  void HAL_timer_disable_interrupt(const uint8_t timer_num) {
+    timers[timer_num].disable();
+  }
+
+  bool HAL_timer_interrupt_enabled(const uint8_t timer_num) {
+    return timers[timer_num].enabled();
+  }
+
+  void HAL_timer_set_compare(const uint8_t timer_num, const hal_timer_t compare) {
+    timers[timer_num].setCompare(compare);
+  }
+
+  hal_timer_t HAL_timer_get_compare(const uint8_t timer_num) {
+    return timers[timer_num].getCompare();
+  }
+
+  hal_timer_t HAL_timer_get_count(const uint8_t timer_num) {
+    return timers[timer_num].getCount();
+  }
+
+#endif
 
 #endif // __PLAT_LINUX__
@@ -95,3 +95,10 @@ bool HAL_timer_interrupt_enabled(const uint8_t timer_num);
 
 #define HAL_timer_isr_prologue(TIMER_NUM)
 #define HAL_timer_isr_epilogue(TIMER_NUM)
+
+#if ENABLED(LINUX_VIRTUAL_TIME)
+  // Run the timer ISRs that come due up to the given simulated time
+  void HAL_timer_run_until(const uint64_t ns);
+  // Simulated time of the next compare match, or UINT64_MAX if no timer is enabled
+  uint64_t HAL_timer_next_event();
+#endif
@@ -51,6 +51,12 @@
 #define READ_PIN(IO)          LPC176x::gpio_get(IO)
 #define WRITE_PIN(IO,V)       LPC176x::gpio_set(IO, V)
 
+// Set / clear several pins of one port with a single write
+#define GPIO_PORT(IO)         LPC176x::pin_port(IO)
+#define GPIO_PORT_MASK(IO)    _BV32(LPC176x::pin_bit(IO))
+#define WRITE_PORT_SET(P,M)   (LPC_GPIO(P)->FIOSET = (M))
+#define WRITE_PORT_CLR(P,M)   (LPC_GPIO(P)->FIOCLR = (M))
+
 /**
  * Magic I/O routines
  *
@@ -84,6 +84,10 @@ void HAL_init() {
   TERN_(EMERGENCY_PARSER, USB_Hook_init());
 }
 
+#if BOTH(SERIAL_DMA, EMERGENCY_PARSER)
+  void HAL_idletask() { MYSERIAL0.dma_idle(); }
+#endif
+
 void HAL_clear_reset_source() { __HAL_RCC_CLEAR_RESET_FLAGS(); }
 
 uint8_t HAL_get_reset_source() {
@@ -171,6 +171,12 @@ extern uint16_t HAL_adc_result;
 // Enable hooks into  setup for HAL
 void HAL_init();
 
+#if BOTH(SERIAL_DMA, EMERGENCY_PARSER)
+  // Scan DMA-received bytes for the emergency parser
+  #define HAL_IDLETASK 1
+  void HAL_idletask();
+#endif
+
 // Clear reset reason
 void HAL_clear_reset_source();
 
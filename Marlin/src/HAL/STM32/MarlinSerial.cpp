@@ -26,6 +26,10 @@
   #include "../../feature/e_parser.h"
 #endif
 
+#if ENABLED(SERIAL_DMA)
+  #include "../shared/DMARxRing.h"
+#endif
+
 #ifndef USART4
   #define USART4 UART4
 #endif
@@ -59,6 +63,9 @@ void MarlinSerial::begin(unsigned long baud, uint8_t config) {
   #if ENABLED(EMERGENCY_PARSER)
     _serial.rx_callback = _rx_callback;
   #endif
+  #if ENABLED(SERIAL_DMA)
+    if (this == &MYSERIAL0) begin_dma();
+  #endif
 }
 
 // This function is Copyright (c) 2006 Nicholas Zambetti.
@@ -85,4 +92,105 @@ void MarlinSerial::_rx_complete_irq(serial_t *obj) {
   }
 }
 
+#if ENABLED(SERIAL_DMA)
+
+  static DMA_HandleTypeDef serial_dma;
+  static uint16_t serial_dma_remaining() { return __HAL_DMA_GET_COUNTER(&serial_dma); }
+  static DMARxRing<RX_BUFFER_SIZE, serial_dma_remaining> serial_rx;
+
+  #if ENABLED(EMERGENCY_PARSER)
+    // The half and full transfer interrupts scan each half of the buffer as it fills
+    static void serial_dma_half_done(DMA_HandleTypeDef*) { MYSERIAL0.dma_scan(); }
+    extern "C" void SERIAL_DMA_IRQHandler() { HAL_DMA_IRQHandler(&serial_dma); }
+  #endif
+
+  /**
+   * Move RX from the per-byte interrupt to a circular DMA transfer into
+   * serial_rx. The UART error interrupts are turned off since the HAL aborts
+   * the transfer on an error. Only EMERGENCY_PARSER enables the DMA interrupt.
+   * If the stream can't be set up the port keeps its RX interrupt.
+   */
+  void MarlinSerial::begin_dma() {
+    UART_HandleTypeDef * const huart = &_serial.handle;
+
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    #ifdef DMA2
+      __HAL_RCC_DMA2_CLK_ENABLE();
+    #endif
+    #ifdef __HAL_RCC_DMAMUX1_CLK_ENABLE
+      __HAL_RCC_DMAMUX1_CLK_ENABLE();
+    #endif
+
+    if (rx_dma) {                             // Baud rate change
+      TERN_(EMERGENCY_PARSER, HAL_NVIC_DisableIRQ(SERIAL_DMA_IRQ));
+      HAL_DMA_DeInit(&serial_dma);
+    }
+    rx_dma = false;
+
+    serial_dma.Instance = SERIAL_DMA_STREAM;
+    #ifdef DMA_SxCR_CHSEL
+      serial_dma.Init.Channel = SERIAL_DMA_CHANNEL;   // F2 / F4 / F7
+    #elif defined(SERIAL_DMA_REQUEST)
+      serial_dma.Init.Request = SERIAL_DMA_REQUEST;   // DMAMUX / CSELR parts
+    #endif
+    serial_dma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    serial_dma.Init.PeriphInc = DMA_PINC_DISABLE;
+    serial_dma.Init.MemInc = DMA_MINC_ENABLE;
+    serial_dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    serial_dma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    serial_dma.Init.Mode = DMA_CIRCULAR;
+    serial_dma.Init.Priority = DMA_PRIORITY_HIGH;
+    #ifdef DMA_SxFCR_DMDIS
+      serial_dma.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    #endif
+    if (HAL_DMA_Init(&serial_dma) != HAL_OK) return;
+    __HAL_LINKDMA(huart, hdmarx, serial_dma);
+
+    HAL_UART_AbortReceive_IT(huart);
+    serial_rx.flush();
+    if (HAL_UART_Receive_DMA(huart, (uint8_t*)serial_rx.buffer, RX_BUFFER_SIZE) != HAL_OK) {
+      HAL_UART_Receive_IT(huart, &(_serial.recv), 1);
+      return;
+    }
+    CLEAR_BIT(huart->Instance->CR1, USART_CR1_PEIE);
+    CLEAR_BIT(huart->Instance->CR3, USART_CR3_EIE);
+
+    #if ENABLED(EMERGENCY_PARSER)
+      // The UART HAL's callbacks would pass the transfer to the RX interrupt
+      // handler, which reads DR, so scan the buffer instead
+      serial_dma.XferHalfCpltCallback = serial_dma.XferCpltCallback = serial_dma_half_done;
+      HAL_NVIC_SetPriority(SERIAL_DMA_IRQ, UART_IRQ_PRIO, UART_IRQ_SUBPRIO);
+      HAL_NVIC_EnableIRQ(SERIAL_DMA_IRQ);
+    #endif
+
+    rx_dma = true;
+  }
+
+  // Pass the bytes that came in since the last scan to the emergency parser
+  void MarlinSerial::dma_scan() {
+    #if ENABLED(EMERGENCY_PARSER)
+      serial_rx.scan([this](const uint8_t c){ emergency_parser.update(emergency_state, c); });
+    #endif
+  }
+
+  /**
+   * Scan the bytes of a half not yet filled, which no DMA interrupt will
+   * report until more come in. Runs on every idle(), so a steady stream
+   * is scanned as it arrives, with the DMA interrupt held off meanwhile.
+   */
+  void MarlinSerial::dma_idle() {
+    #if ENABLED(EMERGENCY_PARSER)
+      if (!rx_dma) return;
+      HAL_NVIC_DisableIRQ(SERIAL_DMA_IRQ);
+      dma_scan();
+      HAL_NVIC_EnableIRQ(SERIAL_DMA_IRQ);
+    #endif
+  }
+
+  int MarlinSerial::available() { return rx_dma ? serial_rx.available() : HardwareSerial::available(); }
+  int MarlinSerial::peek() { return rx_dma ? serial_rx.peek() : HardwareSerial::peek(); }
+  int MarlinSerial::read() { return rx_dma ? serial_rx.read() : HardwareSerial::read(); }
+
+#endif // SERIAL_DMA
+
 #endif // ARDUINO_ARCH_STM32 && !STM32GENERIC
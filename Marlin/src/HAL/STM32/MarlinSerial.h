@@ -40,8 +40,21 @@ public:
 
   void _rx_complete_irq(serial_t* obj);
 
+  #if ENABLED(SERIAL_DMA)
+    // The host port (SERIAL_PORT) receives by circular DMA
+    void begin_dma();
+    void dma_idle();
+    void dma_scan();
+    int available() override;
+    int peek() override;
+    int read() override;
+  #endif
+
 protected:
   usart_rx_callback_t _rx_callback;
+  #if ENABLED(SERIAL_DMA)
+    bool rx_dma = false;
+  #endif
   #if ENABLED(EMERGENCY_PARSER)
     EmergencyParser::State emergency_state;
   #endif
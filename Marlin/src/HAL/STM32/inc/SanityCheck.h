@@ -54,3 +54,15 @@
 #elif ENABLED(SERIAL_STATS_DROPPED_RX)
   #error "SERIAL_STATS_DROPPED_RX is not supported on this platform."
 #endif
+
+#if ENABLED(SERIAL_DMA)
+  #if SERIAL_PORT == -1
+    #error "SERIAL_DMA requires a hardware SERIAL_PORT."
+  #elif !defined(SERIAL_DMA_STREAM)
+    #error "SERIAL_DMA requires SERIAL_DMA_STREAM for the SERIAL_PORT USART RX."
+  #elif defined(DMA_SxCR_CHSEL) && !defined(SERIAL_DMA_CHANNEL)
+    #error "SERIAL_DMA requires SERIAL_DMA_CHANNEL on this MCU."
+  #elif ENABLED(EMERGENCY_PARSER) && !(defined(SERIAL_DMA_IRQ) && defined(SERIAL_DMA_IRQHandler))
+    #error "SERIAL_DMA with EMERGENCY_PARSER requires SERIAL_DMA_IRQ and SERIAL_DMA_IRQHandler for SERIAL_DMA_STREAM."
+  #endif
+#endif
@@ -58,6 +58,8 @@
   #endif
 #endif
 
+#define HAL_SDIO_DMA_READ   // SDIO blocks can be read in the background (sdio.cpp)
+
 #ifdef SERIAL_USB
   #ifndef USE_USB_COMPOSITE
     #define UsbSerial Serial
@@ -81,7 +81,11 @@ bool SDIO_Init() {
   return true;
 }
 
-bool SDIO_ReadBlock_DMA(uint32_t blockAddress, uint8_t *data) {
+/**
+ * Start a DMA block read. Poll SDIO_ReadBusy() until it returns false,
+ * then call SDIO_ReadEnd() for the result.
+ */
+bool SDIO_ReadStart(uint32_t blockAddress, uint8_t *data) {
   if (SDIO_GetCardState() != SDIO_CARD_TRANSFER) return false;
   if (blockAddress >= SdCard.LogBlockNbr) return false;
   if ((0x03 & (uint32_t)data)) return false; // misaligned data
@@ -100,18 +104,25 @@ bool SDIO_ReadBlock_DMA(uint32_t blockAddress, uint8_t *data) {
     dma_disable(SDIO_DMA_DEV, SDIO_DMA_CHANNEL);
     return false;
   }
+  return true;
+}
 
-  while (!SDIO_GET_FLAG(SDIO_STA_DATAEND | SDIO_STA_TRX_ERROR_FLAGS)) { /* wait */ }
+bool SDIO_ReadBusy() {
+  if (!SDIO_GET_FLAG(SDIO_STA_DATAEND | SDIO_STA_TRX_ERROR_FLAGS)) return true;
 
   //If there were SDIO errors, do not wait DMA.
+  if (SDIO->STA & SDIO_STA_TRX_ERROR_FLAGS) return false;
+
+  //Wait for DMA transaction to complete
+  return (DMA2_BASE->ISR & (DMA_ISR_TEIF4|DMA_ISR_TCIF4)) == 0;
+}
+
+bool SDIO_ReadEnd() {
   if (SDIO->STA & SDIO_STA_TRX_ERROR_FLAGS) {
     SDIO_CLEAR_FLAG(SDIO_ICR_CMD_FLAGS | SDIO_ICR_DATA_FLAGS);
     dma_disable(SDIO_DMA_DEV, SDIO_DMA_CHANNEL);
     return false;
-	}
-
-  //Wait for DMA transaction to complete
-  while ((DMA2_BASE->ISR & (DMA_ISR_TEIF4|DMA_ISR_TCIF4)) == 0 ) { /* wait */ }
+  }
 
   if (DMA2_BASE->ISR & DMA_ISR_TEIF4) {
     dma_disable(SDIO_DMA_DEV, SDIO_DMA_CHANNEL);
@@ -135,6 +146,12 @@ bool SDIO_ReadBlock_DMA(uint32_t blockAddress, uint8_t *data) {
   return true;
 }
 
+bool SDIO_ReadBlock_DMA(uint32_t blockAddress, uint8_t *data) {
+  if (!SDIO_ReadStart(blockAddress, data)) return false;
+  while (SDIO_ReadBusy()) { /* wait */ }
+  return SDIO_ReadEnd();
+}
+
 bool SDIO_ReadBlock(uint32_t blockAddress, uint8_t *data) {
   uint32_t retries = SDIO_READ_RETRIES;
   while (retries--) if (SDIO_ReadBlock_DMA(blockAddress, data)) return true;
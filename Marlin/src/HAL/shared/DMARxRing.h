@@ -0,0 +1,76 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Serial RX by a circular DMA transfer
+ *
+ * The DMA channel copies each received byte into buffer[] and counts its
+ * transfer down from SIZE, starting over at the end, so no interrupt runs
+ * per byte. The write position is SIZE - REMAINING(), read from the DMA
+ * counter, and the reader keeps its own position. read_serial() gets the
+ * same available() / peek() / read() as with an interrupt-fed buffer.
+ *
+ * No interrupt runs per byte. The HAL calls scan() from idle() and from
+ * the DMA half and full transfer interrupts, to hand the new bytes to the
+ * emergency parser before the DMA can come round to them again.
+ *
+ * If more than SIZE - 1 bytes go unread the DMA overwrites them. The host
+ * has to keep within the buffer, as with WINDOWED_OK.
+ */
+
+#include "../../core/macros.h"
+
+template<uint16_t SIZE, uint16_t (*REMAINING)()>
+class DMARxRing {
+  static_assert(SIZE >= 2 && !((SIZE) & ((SIZE) - 1)), "DMARxRing SIZE must be a power of 2.");
+  static constexpr uint16_t MASK = SIZE - 1;
+
+  uint16_t tail = 0, scanned = 0;
+
+  // The counter reads SIZE for a moment as it reloads, which masks to 0
+  static inline uint16_t head() { return (SIZE - REMAINING()) & MASK; }
+
+public:
+  volatile uint8_t buffer[SIZE];  // The DMA destination
+
+  inline int available() { return (head() - tail) & MASK; }
+
+  inline int peek() { return head() == tail ? -1 : buffer[tail]; }
+
+  inline int read() {
+    if (head() == tail) return -1;
+    const uint8_t c = buffer[tail];
+    tail = (tail + 1) & MASK;
+    return c;
+  }
+
+  // Drop everything received so far
+  inline void flush() { tail = scanned = head(); }
+
+  // Pass each byte that came in since the last scan to fn()
+  template<typename F>
+  inline void scan(F fn) {
+    for (const uint16_t h = head(); scanned != h; scanned = (scanned + 1) & MASK)
+      fn(buffer[scanned]);
+  }
+};
@@ -79,6 +79,14 @@
   #include "feature/direct_stepping.h"
 #endif
 
+#if ENABLED(STEP_SEGMENT_QUEUE)
+  #include "feature/step_segments.h"
+#endif
+
+#if ENABLED(ISR_PROFILER)
+  #include "feature/isr_profiler.h"
+#endif
+
 #if ENABLED(TOUCH_BUTTONS)
   #include "feature/touch/xpt2046.h"
 #endif
@@ -690,6 +698,12 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
   // Handle filament runout sensors
   TERN_(HAS_FILAMENT_SENSOR, runout.run());
 
+  // Build user thermistor tables a little at a time
+  TERN_(FAST_USER_THERMISTORS, thermalManager.build_user_thermistor_tables());
+
+  // Prepare step timing for the Stepper ISR
+  TERN_(STEP_SEGMENT_QUEUE, step_segments.compile());
+
   // Run HAL idle tasks
   #ifdef HAL_IDLETASK
     HAL_idletask();
@@ -711,6 +725,9 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
   // Handle SD Card insert / remove
   TERN_(SDSUPPORT, card.manage_media());
 
+  // Read ahead in the file being printed
+  TERN_(SD_READ_AHEAD, sd_read_ahead.fill());
+
   // Handle USB Flash Drive insert / remove
   TERN_(USB_FLASH_DRIVE_SUPPORT, Sd2Card::idle());
 
@@ -969,8 +986,12 @@ void setup() {
     SERIAL_ECHO_MSG("Compiled: " __DATE__);
   #endif
 
+  #if ENABLED(ADAPTIVE_BLOCK_BUFFER)
+    SETUP_RUN(planner.allocate_block_buffer());
+  #endif
+
   SERIAL_ECHO_START();
-  SERIAL_ECHOLNPAIR(STR_FREE_MEMORY, freeMemory(), STR_PLANNER_BUFFER_BYTES, (int)sizeof(block_t) * (BLOCK_BUFFER_SIZE));
+  SERIAL_ECHOLNPAIR(STR_FREE_MEMORY, freeMemory(), STR_PLANNER_BUFFER_BYTES, (int)sizeof(block_t) * (BLOCK_BUFFER_DEPTH));
 
   // Set up LEDs early
   #if HAS_COLOR_LEDS
@@ -1192,6 +1213,10 @@ void setup() {
     SETUP_RUN(page_manager.init());
   #endif
 
+  #if ENABLED(ISR_PROFILER)
+    SETUP_RUN(isr_profiler.init());
+  #endif
+
   #if ENABLED(TFT_LVGL_UI)
     if (!card.isMounted()) SETUP_RUN(card.mount()); // Mount SD to load graphics and fonts
     SETUP_RUN(tft_lvgl_init());
@@ -1227,6 +1252,9 @@ void loop() {
 
     queue.advance();
 
+    // Between commands, so the cache compiler can use the parser
+    TERN_(SD_GCODE_CACHE, gcode_cache.compile_step());
+
     endstops.event_handler();
 
     TERN_(TFT_LVGL_UI, printer_state_polling());
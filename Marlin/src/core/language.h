@@ -243,6 +243,15 @@
 #define STR_PID_DEBUG_DTERM                 " dTerm "
 #define STR_PID_DEBUG_CTERM                 " cTerm "
 #define STR_INVALID_EXTRUDER_NUM            " - Invalid extruder number !"
+#define STR_MPC_AUTOTUNE_START              "MPC Autotune start for E"
+#define STR_MPC_COOLING_TO_AMBIENT          "Cooling to ambient"
+#define STR_MPC_HEATING_PAST_200            "Heating to over 200C"
+#define STR_MPC_MEASURING_AMBIENT           "Measuring ambient heat loss at "
+#define STR_MPC_TEMP_TOO_HIGH               "MPC Autotune failed! Temperature too high"
+#define STR_MPC_TEMPERATURE_ERROR           "MPC Autotune failed! Temperature out of range"
+#define STR_MPC_TIMEOUT                     "MPC Autotune failed! timeout"
+#define STR_MPC_AUTOTUNE_INTERRUPTED        "MPC Autotune interrupted!"
+#define STR_MPC_AUTOTUNE_FINISHED           "MPC Autotune finished! Save the constants below with M500 or put them into Configuration.h"
 
 #define STR_HEATER_BED                      "bed"
 #define STR_HEATER_CHAMBER                  "chamber"
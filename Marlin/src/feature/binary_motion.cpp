@@ -0,0 +1,111 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#if ENABLED(BINARY_MOTION_PROTOCOL)
+
+#include "binary_motion.h"
+#include "../gcode/queue.h"
+#include "../gcode/parser.h"
+
+constexpr char BinaryMotionProtocol::field_letter[];
+int64_t BinaryMotionProtocol::last[COUNT(field_letter)];
+uint8_t BinaryMotionProtocol::moves[MAX_CMD_SIZE];
+uint16_t BinaryMotionProtocol::moves_len, BinaryMotionProtocol::moves_pos;
+
+// Read a zigzag varint. Return false if it runs past the end.
+static bool read_delta(const uint8_t* &p, const uint8_t * const end, int32_t &out) {
+  uint32_t v = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (p >= end) return false;
+    const uint8_t b = *p++;
+    v |= uint32_t(b & 0x7F) << shift;
+    if (!(b & 0x80)) { out = int32_t(v >> 1) ^ -int32_t(v & 1); return true; }
+  }
+  return false;
+}
+
+void BinaryMotionProtocol::process(const uint8_t packet_type, const char * const buffer, const uint16_t length) {
+  switch (static_cast<Motion>(packet_type)) {
+    case Motion::QUERY:
+      SERIAL_ECHOLNPAIR("PBM:version:", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH, ":units:1000,100000,1");
+      break;
+    case Motion::RESET:
+      ZERO(last);
+      break;
+    case Motion::MOVE:
+      // The packet buffer is the next queue line, so keep a copy to queue from
+      moves_len = _MIN(length, sizeof(moves));
+      memcpy(moves, buffer, moves_len);
+      moves_pos = 0;
+      break;
+    default:
+      SERIAL_ECHOLNPGM("PBM:invalid");
+      break;
+  }
+}
+
+/**
+ * Decode the packet one record at a time into queue moves:
+ * the flags byte, then a float for each field it flags.
+ */
+bool BinaryMotionProtocol::drain() {
+  while (pending()) {
+    const uint8_t *p = &moves[moves_pos], * const end = &moves[moves_len];
+    int64_t next[COUNT(field_letter)];
+    COPY(next, last);
+
+    char rec[1 + COUNT(field_letter) * sizeof(float)];
+    uint8_t len = 0;
+    const uint8_t flags = rec[len++] = *p++;
+    LOOP_L_N(f, COUNT(field_letter)) {
+      if (!TEST(flags, _MIN(f, 5))) continue;     // I and J share bit 5
+      int32_t delta;
+      if (!read_delta(p, end, delta)) { SERIAL_ECHOLNPGM("PBM:invalid"); moves_len = 0; return true; }
+      next[f] += delta;
+      const float v = float(next[f]) / (f == 3 ? 100000.0f : f == 4 ? 1.0f : 1000.0f);
+      memcpy(&rec[len], &v, sizeof(v));
+      len += sizeof(v);
+    }
+
+    if (!queue.enqueue_move(rec, len)) return false;
+    COPY(last, next);
+    moves_pos = p - moves;
+  }
+  return true;
+}
+
+void BinaryMotionProtocol::load(const char * const rec) {
+  const uint8_t flags = rec[0];
+  const char *p = &rec[1];
+  parser.set_command('G', flags >> 6);
+  LOOP_L_N(f, COUNT(field_letter)) {
+    if (!TEST(flags, _MIN(f, 5))) continue;
+    float v;
+    memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    parser.set_value(field_letter[f], v);
+  }
+}
+
+#endif // BINARY_MOTION_PROTOCOL
@@ -0,0 +1,67 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include "../inc/MarlinConfig.h"
+
+/**
+ * Motion channel: packed G0-G3 records, run exactly as the G-code they stand
+ * for, but with no text to format or parse.
+ *
+ * A MOVE packet holds any number of records. A record is a flags byte and
+ * then the fields it flags, in the order X Y Z E F I J:
+ *   bits 0-3 : X, Y, Z, E present
+ *   bit 4    : F present
+ *   bit 5    : I and J present (G2/G3)
+ *   bits 6-7 : 0=G0, 1=G1, 2=G2, 3=G3
+ * A field is a zigzag varint of the change from the last value sent in that
+ * field, so a short segment takes about 2 bytes per axis. Values are the
+ * G-code parameter values in fixed point: 1/1000 for X Y Z I J, 1/100000
+ * for E, and 1 for F. RESET sets all the last values back to 0.
+ *
+ * The stream only keeps a MOVE packet. The serial reader feeds its records
+ * to the command queue as decoded moves, and the main loop runs them in
+ * order with the other commands. No more packets are read until the whole
+ * packet is queued.
+ */
+class BinaryMotionProtocol {
+public:
+  static void process(const uint8_t packet_type, const char * const buffer, const uint16_t length);
+
+  // A MOVE packet is still waiting to be queued
+  static inline bool pending() { return moves_pos < moves_len; }
+
+  // Queue the moves of the packet. Return false if the queue filled up first.
+  static bool drain();
+
+  // Load a queued move into the parser
+  static void load(const char * const rec);
+
+  static const uint16_t VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0;
+
+private:
+  enum class Motion : uint8_t { QUERY, RESET, MOVE };
+  static constexpr char field_letter[7] = { 'X', 'Y', 'Z', 'E', 'F', 'I', 'J' };
+  static int64_t last[COUNT(field_letter)];   // Wide, so absolute E can pass 21474 mm
+  static uint8_t moves[MAX_CMD_SIZE];
+  static uint16_t moves_len, moves_pos;
+};
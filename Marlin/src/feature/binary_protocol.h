@@ -29,6 +29,10 @@
   #include "../libs/heatshrink/heatshrink_decoder.h"
 #endif
 
+#if ENABLED(BINARY_MOTION_PROTOCOL)
+  #include "binary_motion.h"
+#endif
+
 inline bool bs_serial_data_available(const uint8_t index) {
   switch (index) {
     case 0: return MYSERIAL0.available();
@@ -214,7 +218,7 @@ public:
 
 class BinaryStream {
 public:
-  enum class Protocol : uint8_t { CONTROL, FILE_TRANSFER };
+  enum class Protocol : uint8_t { CONTROL, FILE_TRANSFER, MOTION };
 
   enum class ProtocolControl : uint8_t { SYNC = 1, CLOSE };
 
@@ -413,6 +417,8 @@ public:
           SERIAL_ECHOLNPAIR("ok", packet.header.sync); // transmit valid packet received
           dispatch();
           stream_state = StreamState::PACKET_RESET;
+          // Queue the moves of a MOTION packet before reading another packet
+          if (TERN0(BINARY_MOTION_PROTOCOL, BinaryMotionProtocol::pending())) return;
           break;
         case StreamState::PACKET_RESEND:
           if (packet_retries < MAX_RETRIES || MAX_RETRIES == 0) {
@@ -454,6 +460,11 @@ public:
       case Protocol::FILE_TRANSFER:
         SDFileTransferProtocol::process(packet.header.type(), packet.buffer, packet.header.size); // send user data to be processed
       break;
+      #if ENABLED(BINARY_MOTION_PROTOCOL)
+        case Protocol::MOTION:
+          BinaryMotionProtocol::process(packet.header.type(), packet.buffer, packet.header.size);
+          break;
+      #endif
       default:
         SERIAL_ECHO_MSG("Unsupported Binary Protocol");
     }
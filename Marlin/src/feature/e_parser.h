@@ -74,6 +74,8 @@ public:
 
   FORCE_INLINE static void disable() { enabled = false; }
 
+  FORCE_INLINE static bool is_enabled() { return enabled; }
+
   FORCE_INLINE static void update(State &state, const uint8_t c) {
     #define ISEOL(C) ((C) == '\n' || (C) == '\r')
     switch (state) {
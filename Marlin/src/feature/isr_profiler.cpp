@@ -0,0 +1,100 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * isr_profiler.cpp - Measure the CPU cycles spent in the Stepper and Temperature ISRs
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(ISR_PROFILER)
+
+#include "isr_profiler.h"
+#include "../module/stepper.h"
+
+ISRProfiler isr_profiler;
+
+isr_profile_t ISRProfiler::profile[ISR_PROFILE_COUNT];
+
+void ISRProfiler::init() {
+  #if defined(__arm__) || defined(__thumb__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    #if __CORTEX_M == 7
+      DWT->LAR = 0xC5ACCE55; // Unlock DWT on the M7
+    #endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  #endif
+  reset();
+}
+
+void ISRProfiler::reset() {
+  LOOP_L_N(s, ISR_PROFILE_COUNT) {
+    CRITICAL_SECTION_START();
+    profile[s] = isr_profile_t();
+    profile[s].min = UINT32_MAX;
+    CRITICAL_SECTION_END();
+  }
+}
+
+static void report_section(PGM_P const name, const ISRProfileSection s, const uint32_t estimate) {
+  CRITICAL_SECTION_START();
+  const isr_profile_t p = ISRProfiler::profile[s];
+  CRITICAL_SECTION_END();
+
+  SERIAL_ECHO_START();
+  serialprintPGM(name);
+  SERIAL_ECHOPAIR(" calls:", p.calls);
+  if (p.calls) {
+    SERIAL_ECHOPAIR(" min:", p.min, " avg:", uint32_t(p.total / p.calls), " max:", p.max);
+    SERIAL_ECHOPAIR(" max_us:", p.max / ((F_CPU) / 1000000UL));
+  }
+  if (estimate) SERIAL_ECHOPAIR(" est:", estimate);
+  SERIAL_EOL();
+
+  if (!p.calls) return;
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPGM("  histogram");
+  LOOP_L_N(b, ISR_PROFILE_BUCKETS) {
+    if (!p.histogram[b]) continue;
+    SERIAL_CHAR(' ');
+    if (b) SERIAL_ECHO(32UL << b); else SERIAL_CHAR('0');
+    SERIAL_ECHOPAIR("+:", p.histogram[b]);
+  }
+  SERIAL_EOL();
+}
+
+/**
+ * Report the cycles of each ISR, with the estimates from stepper.h
+ * (for one step per Stepper ISR) where there is one.
+ */
+void ISRProfiler::report() {
+  SERIAL_ECHO_START();
+  SERIAL_ECHOLNPAIR("ISR cycles at ", uint32_t((F_CPU) / 1000000UL), "MHz");
+  report_section(PSTR("Stepper"),     ISR_PROFILE_STEPPER,     ISR_EXECUTION_CYCLES(1));
+  report_section(PSTR("Pulse phase"), ISR_PROFILE_PULSE_PHASE, ISR_LOOP_CYCLES);
+  report_section(PSTR("Block phase"), ISR_PROFILE_BLOCK_PHASE, 0);
+  report_section(PSTR("Advance"),     ISR_PROFILE_ADVANCE,     ISR_LA_LOOP_CYCLES);
+  report_section(PSTR("Temperature"), ISR_PROFILE_TEMPERATURE, 0);
+}
+
+#endif // ISR_PROFILER
@@ -0,0 +1,108 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * isr_profiler.h - Measure the CPU cycles spent in the Stepper and Temperature ISRs
+ *
+ * The cycle source depends on the platform:
+ *  - ARM Cortex-M3/M4/M7: the DWT cycle counter (CYCCNT).
+ *  - AVR: the Stepper timer count (Timer1). It resets on each Stepper ISR,
+ *    so samples that wrap around are dropped.
+ *  - Linux: the simulated clock, scaled to F_CPU.
+ *
+ * Times include any interrupts nested in the measured one.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+enum ISRProfileSection : uint8_t {
+  ISR_PROFILE_STEPPER,      // Stepper::isr, including the phases below
+  ISR_PROFILE_PULSE_PHASE,  // Stepper::pulse_phase_isr
+  ISR_PROFILE_BLOCK_PHASE,  // Stepper::block_phase_isr
+  ISR_PROFILE_ADVANCE,      // Stepper::advance_isr (LIN_ADVANCE)
+  ISR_PROFILE_TEMPERATURE,  // Temperature::tick
+  ISR_PROFILE_COUNT
+};
+
+// Bucket 0 counts samples under 64 cycles, bucket n those in [2^(n+5), 2^(n+6)), the last one the rest
+#define ISR_PROFILE_BUCKETS 12
+
+typedef struct {
+  uint32_t calls, min, max;
+  uint64_t total;
+  uint32_t histogram[ISR_PROFILE_BUCKETS];
+} isr_profile_t;
+
+class ISRProfiler {
+public:
+  static isr_profile_t profile[ISR_PROFILE_COUNT];
+
+  static void init();
+  static void reset();
+  static void report();
+
+  // Read the cycle source
+  FORCE_INLINE static uint32_t now() {
+    #if defined(__arm__) || defined(__thumb__)
+      return DWT->CYCCNT;
+    #elif defined(__AVR__)
+      return TCNT1;
+    #else
+      return Clock::nanos() * ((F_CPU) / 1000000UL) / 1000UL;
+    #endif
+  }
+
+  // Add a sample that started at the given now() value
+  FORCE_INLINE static void record(const ISRProfileSection s, const uint32_t start) {
+    #ifdef __AVR__
+      const uint16_t end = TCNT1;
+      if (end < uint16_t(start)) return;  // The timer wrapped
+      const uint32_t cycles = uint32_t(end - uint16_t(start)) * ((F_CPU) / (STEPPER_TIMER_RATE));
+    #else
+      const uint32_t cycles = now() - start;
+    #endif
+
+    isr_profile_t &p = profile[s];
+    p.calls++;
+    p.total += cycles;
+    NOMORE(p.min, cycles);
+    NOLESS(p.max, cycles);
+
+    uint8_t b = 0;
+    for (uint32_t c = cycles >> 6; c && b < ISR_PROFILE_BUCKETS - 1; c >>= 1) b++;
+    p.histogram[b]++;
+  }
+};
+
+// Profile the enclosing scope into the given section
+class ISRProfileScope {
+  const ISRProfileSection s;
+  const uint32_t start;
+public:
+  FORCE_INLINE ISRProfileScope(const ISRProfileSection s) : s(s), start(ISRProfiler::now()) {}
+  FORCE_INLINE ~ISRProfileScope() { ISRProfiler::record(s, start); }
+};
+
+#define ISR_PROFILE(S) ISRProfileScope _isr_profile_scope(ISR_PROFILE_##S)
+
+extern ISRProfiler isr_profiler;
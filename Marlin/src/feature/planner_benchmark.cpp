@@ -0,0 +1,289 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * planner_benchmark.cpp - Host-side planner / stepper throughput benchmark
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(PLANNER_BENCHMARK)
+
+#include "planner_benchmark.h"
+#include "../module/planner.h"
+#include "../module/motion.h"
+#include "../module/temperature.h"
+#include "../gcode/gcode.h"
+#include "../gcode/parser.h"
+
+#if ENABLED(STEP_SEGMENT_QUEUE)
+  #include "step_segments.h"
+#endif
+
+#include <stdio.h>
+#include <ctype.h>
+
+bench_section_t PlannerBenchmark::section[BENCH_SECTION_COUNT];
+uint32_t PlannerBenchmark::lines, PlannerBenchmark::blocks;
+uint32_t PlannerBenchmark::rate_histogram[BENCH_RATE_BUCKETS];
+uint64_t PlannerBenchmark::step_ticks;
+uint16_t PlannerBenchmark::kernel_run[BENCH_KERNEL_COUNT];
+bench_kernel_t PlannerBenchmark::kernel[BENCH_KERNEL_COUNT];
+#if ENABLED(VECTOR_JUNCTION_DEVIATION)
+  bench_junction_t PlannerBenchmark::junction;
+#endif
+#if ENABLED(INCREMENTAL_REPLANNING)
+  bench_replan_t PlannerBenchmark::replan;
+#endif
+bool PlannerBenchmark::shadowing;
+#if ENABLED(STEP_SEGMENT_QUEUE)
+  bool PlannerBenchmark::starve, PlannerBenchmark::no_compiler, PlannerBenchmark::trickle;
+  uint32_t PlannerBenchmark::isr_calls;
+#endif
+
+void PlannerBenchmark::reset() {
+  ZERO(section);
+  ZERO(rate_histogram);
+  ZERO(kernel_run);
+  ZERO(kernel);
+  TERN_(VECTOR_JUNCTION_DEVIATION, junction = bench_junction_t());
+  TERN_(INCREMENTAL_REPLANNING, replan = bench_replan_t());
+  TERN_(STEP_SEGMENT_QUEUE, step_segments.underruns = 0);
+  lines = blocks = 0;
+  step_ticks = 0;
+}
+
+void PlannerBenchmark::record_step_interval(const hal_timer_t ticks) {
+  if (!ticks) return;
+  step_ticks += ticks;
+  uint32_t rate = (STEPPER_TIMER_RATE) / ticks;
+  uint8_t b = 0;
+  while (rate >>= 1) b++;
+  rate_histogram[_MIN(b, BENCH_RATE_BUCKETS - 1)]++;
+}
+
+/**
+ * Commands that wait on real hardware (heaters, endstops, the user)
+ * would stall or skew the replay, so they are dropped.
+ */
+bool PlannerBenchmark::skip_command(const char * const cmd) {
+  static const char * const skipped[] = {
+    "G4", "G28", "G29", "M0", "M1", "M109", "M190", "M191", "M303", "M600"
+  };
+  for (const char * const s : skipped) {
+    const size_t len = strlen(s);
+    if (!strncmp(cmd, s, len) && !NUMERIC(cmd[len])) return true;
+  }
+  return false;
+}
+
+bool PlannerBenchmark::replay(const char * const path) {
+  FILE * const f = fopen(path, "r");
+  if (!f) return false;
+
+  // Every replay starts from the origin
+  current_position.reset();
+  sync_plan_position();
+
+  char line[MAX_CMD_SIZE * 2];
+  while (fgets(line, sizeof(line), f)) {
+    // Strip comments and trailing whitespace
+    char *p = strchr(line, ';');
+    if (p) *p = '\0';
+    p = line + strlen(line);
+    while (p > line && isspace(p[-1])) *--p = '\0';
+
+    char *cmd = line;
+    while (isspace(*cmd)) cmd++;
+    if (!*cmd || skip_command(cmd)) continue;
+
+    lines++;
+    parser.parse(cmd);
+    gcode.process_parsed_command(true);
+
+    #if ENABLED(STEP_SEGMENT_QUEUE)
+      // Keep the planner queue short, as with a slow host
+      while (trickle && planner.movesplanned() > BENCH_TRICKLE_BLOCKS) {
+        const uint8_t tail = planner.block_buffer_tail;
+        HAL_idletask();
+        if (tail == planner.block_buffer_tail) break;
+      }
+    #endif
+  }
+  fclose(f);
+
+  planner.synchronize();
+  return true;
+}
+
+static void report_kernel(const char * const name, const bench_kernel_t &k, const uint32_t replans) {
+  printf("  %-14s total %10u  per recalculate avg %6.2f  max %5u\n",
+    name, k.total, replans ? float(k.total) / replans : 0.0f, k.max
+  );
+}
+
+static void report_section(const char * const name, const bench_section_t &sec) {
+  printf("  %-14s calls %10u  total %10.3f ms  avg %8.3f us  max %8.3f us\n",
+    name, sec.calls, sec.total_ns * 1e-6,
+    sec.calls ? sec.total_ns * 1e-3 / sec.calls : 0.0,
+    sec.max_ns * 1e-3
+  );
+}
+
+void PlannerBenchmark::report(const char * const path, const uint64_t elapsed_ns) {
+  const uint64_t planner_ns = section[BENCH_POPULATE_BLOCK].total_ns + section[BENCH_RECALCULATE].total_ns;
+
+  printf("Planner benchmark: %s\n", path);
+  printf("  lines %u  blocks %u  elapsed %.3f s  move time %.3f s\n",
+    lines, blocks, elapsed_ns * 1e-9, double(step_ticks) / (STEPPER_TIMER_RATE)
+  );
+  printf("  blocks/s (wall) %.1f  blocks/s (planner) %.1f\n",
+    elapsed_ns ? blocks * 1e9 / elapsed_ns : 0.0,
+    planner_ns ? blocks * 1e9 / planner_ns : 0.0
+  );
+
+  report_section("buffer_line",   section[BENCH_BUFFER_LINE]);
+  report_section("populate",      section[BENCH_POPULATE_BLOCK]);
+  report_section("recalculate",   section[BENCH_RECALCULATE]);
+  report_section("reverse_pass",  section[BENCH_REVERSE_PASS]);
+  report_section("forward_pass",  section[BENCH_FORWARD_PASS]);
+  report_section("trapezoids",    section[BENCH_TRAPEZOIDS]);
+  report_section("stepper_isr",   section[BENCH_STEPPER_ISR]);
+
+  printf("  kernels%s:\n", ENABLED(INCREMENTAL_REPLANNING) ? " (incremental replanning)" : "");
+  const uint32_t replans = section[BENCH_RECALCULATE].calls;
+  report_kernel("reverse",        kernel[BENCH_KERNEL_REVERSE],   replans);
+  report_kernel("forward",        kernel[BENCH_KERNEL_FORWARD],   replans);
+  report_kernel("trapezoid",      kernel[BENCH_KERNEL_TRAPEZOID], replans);
+
+  #if ENABLED(VECTOR_JUNCTION_DEVIATION)
+    printf("  vector junctions %u  max relative deviation %.3g  over tolerance %u\n",
+      junction.checked, double(junction.max_error), junction.failed
+    );
+  #endif
+
+  #if ENABLED(INCREMENTAL_REPLANNING)
+    printf("  incremental replans checked against full replans: blocks %u  different %u\n", replan.checked, replan.failed);
+  #endif
+
+  #if ENABLED(STEP_SEGMENT_QUEUE)
+    printf("  step segment queue underruns %u\n", step_segments.underruns);
+  #endif
+
+  printf("  step ISR rate histogram (Hz):\n");
+  LOOP_L_N(b, BENCH_RATE_BUCKETS)
+    if (rate_histogram[b])
+      printf("    %9lu - %9lu : %u\n", 1UL << b, (2UL << b) - 1, rate_histogram[b]);
+
+  fflush(stdout);
+}
+
+#if ENABLED(STEP_SEGMENT_QUEUE)
+
+  /**
+   * Replay a file again with the segment compiler starved. The Stepper ISR
+   * must run out of segments and fall back to its own trapezoid math, and
+   * the moves must take the same time as with the queue kept full.
+   * Return false if there were no underruns or the time is off.
+   */
+  bool PlannerBenchmark::replay_starved(const char * const path) {
+    const uint64_t full_ticks = step_ticks;
+    reset();
+    starve = true;
+    isr_calls = 0;
+    replay(path);
+    starve = false;
+
+    const float deviation = full_ticks ? ABS(float(int64_t(step_ticks - full_ticks))) / full_ticks : 0.0f;
+    printf("  starved segment queue: underruns %u  move time %.3f s  deviation %.3g\n",
+      step_segments.underruns, double(step_ticks) / (STEPPER_TIMER_RATE), double(deviation)
+    );
+    fflush(stdout);
+    return step_segments.underruns && deviation <= BENCH_STARVE_TOLERANCE;
+  }
+
+  /**
+   * Replay a file fed in one block at a time, first with the segment
+   * compiler off (the Stepper ISR plans every block, as without the queue)
+   * and then with it on. The compiler must leave the newest blocks to the
+   * planner, or they stop at MINIMUM_PLANNER_SPEED and the moves take longer.
+   * Return false if the move times differ by more than the tolerance.
+   */
+  bool PlannerBenchmark::replay_trickle(const char * const path) {
+    trickle = true;
+
+    reset();
+    no_compiler = true;
+    replay(path);
+    no_compiler = false;
+    const uint64_t isr_ticks = step_ticks;
+
+    reset();
+    replay(path);
+    trickle = false;
+
+    const float deviation = isr_ticks ? ABS(float(int64_t(step_ticks - isr_ticks))) / isr_ticks : 0.0f;
+    printf("  one block at a time: move time %.3f s  without segment queue %.3f s  deviation %.3g\n",
+      double(step_ticks) / (STEPPER_TIMER_RATE), double(isr_ticks) / (STEPPER_TIMER_RATE), double(deviation)
+    );
+    fflush(stdout);
+    return deviation <= BENCH_STARVE_TOLERANCE;
+  }
+
+#endif
+
+/**
+ * Replay each file in turn and print a report for it.
+ * Return a process exit status, failing if a file can't be read or
+ * a vector junction speed is out of tolerance, or an incremental replan
+ * differs from a full one, or the moves don't hold their timing through
+ * segment queue underruns or with a short planner queue.
+ */
+int PlannerBenchmark::run(const int file_count, char * const files[]) {
+  if (file_count < 1) {
+    printf("Usage: marlin <file.gcode> [file.gcode ...]\n");
+    return 1;
+  }
+
+  TERN_(PREVENT_COLD_EXTRUSION, thermalManager.allow_cold_extrude = true);
+
+  int status = 0;
+  LOOP_L_N(i, file_count) {
+    reset();
+    const uint64_t start_ns = nanos();
+    if (!replay(files[i])) {
+      printf("Planner benchmark: can't open %s\n", files[i]);
+      status = 1;
+      continue;
+    }
+    report(files[i], nanos() - start_ns);
+    if (TERN0(VECTOR_JUNCTION_DEVIATION, junction.failed)) status = 1;
+    if (TERN0(INCREMENTAL_REPLANNING, replan.failed)) status = 1;
+    #if ENABLED(STEP_SEGMENT_QUEUE)
+      if (!replay_starved(files[i])) status = 1;
+      if (!replay_trickle(files[i])) status = 1;
+    #endif
+  }
+  return status;
+}
+
+#endif // PLANNER_BENCHMARK
@@ -0,0 +1,189 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * planner_benchmark.h - Host-side planner / stepper throughput benchmark
+ *
+ * Only available on HAL/LINUX. G-code files given on the command line are
+ * replayed straight into the parser and the stepper ISR is run inline
+ * whenever the planner needs a free block, so a job runs as fast as the
+ * host allows instead of in real time.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(INCREMENTAL_REPLANNING)
+  #include "../module/planner.h"
+#endif
+
+enum BenchSection : uint8_t {
+  BENCH_BUFFER_LINE,      // Planner::buffer_line, including waits for a free block
+  BENCH_POPULATE_BLOCK,   // Planner::_populate_block
+  BENCH_RECALCULATE,      // Planner::recalculate, including the passes below
+  BENCH_REVERSE_PASS,     // Planner::reverse_pass
+  BENCH_FORWARD_PASS,     // Planner::forward_pass
+  BENCH_TRAPEZOIDS,       // Planner::recalculate_trapezoids
+  BENCH_STEPPER_ISR,      // Stepper::isr, run inline to drain the planner
+  BENCH_SECTION_COUNT
+};
+
+enum BenchKernel : uint8_t {
+  BENCH_KERNEL_REVERSE,   // Planner::reverse_pass_kernel
+  BENCH_KERNEL_FORWARD,   // Planner::forward_pass_kernel
+  BENCH_KERNEL_TRAPEZOID, // Planner::calculate_trapezoid_for_block
+  BENCH_KERNEL_COUNT
+};
+
+// Step ISR rates are binned by powers of two: bucket n counts rates in [2^n, 2^(n+1)) Hz
+#define BENCH_RATE_BUCKETS 24
+
+typedef struct {
+  uint32_t calls;
+  uint64_t total_ns, max_ns;
+} bench_section_t;
+
+typedef struct {
+  uint32_t total, max;
+} bench_kernel_t;
+
+#if ENABLED(VECTOR_JUNCTION_DEVIATION)
+  // Relative deviation of the vector junction speeds from the scalar math
+  #define BENCH_JUNCTION_TOLERANCE 1e-4f
+  typedef struct {
+    uint32_t checked, failed;
+    float max_error;
+  } bench_junction_t;
+#endif
+
+#if ENABLED(INCREMENTAL_REPLANNING)
+  // Blocks whose incremental replan differs from a full replan
+  typedef struct {
+    uint32_t checked, failed;
+  } bench_replan_t;
+#endif
+
+#if ENABLED(STEP_SEGMENT_QUEUE)
+  // Each file is replayed again with the segment compiler held off for this
+  // many Stepper ISR calls out of every two lots, to force queue underruns.
+  // The moves must take about as long as with the queue kept full. A segment
+  // runs all its ISR calls at the interval of the middle one, where the
+  // Stepper ISR's own math steps the rate every call. That comes to around
+  // 2e-5 of the move time, so allow 1e-4.
+  #define BENCH_STARVE_ISRS     4096
+  #define BENCH_STARVE_TOLERANCE 0.0001f
+  // Then it is fed in one block at a time, with the Stepper ISR run until
+  // no more than this many blocks are queued after each line, once with the
+  // compiler and once without. The compiler must not freeze blocks the
+  // planner could still speed up, so both must take about as long.
+  #define BENCH_TRICKLE_BLOCKS  4
+#endif
+
+class PlannerBenchmark {
+public:
+  static bench_section_t section[BENCH_SECTION_COUNT];
+  static uint32_t lines, blocks;
+  static uint32_t rate_histogram[BENCH_RATE_BUCKETS];
+  static uint64_t step_ticks;                       // Stepper timer ticks taken by the moves
+  static uint16_t kernel_run[BENCH_KERNEL_COUNT];   // Kernels run by the current recalculate()
+  static bench_kernel_t kernel[BENCH_KERNEL_COUNT];
+  #if ENABLED(VECTOR_JUNCTION_DEVIATION)
+    static bench_junction_t junction;
+  #endif
+  #if ENABLED(INCREMENTAL_REPLANNING)
+    static bench_replan_t replan;
+  #endif
+  static bool shadowing;                            // Running the full replan of the shadow check, so don't count it
+
+  #if ENABLED(STEP_SEGMENT_QUEUE)
+    static bool starve, no_compiler, trickle;
+    static uint32_t isr_calls;
+    // Should the segment compiler be skipped before this Stepper ISR call?
+    static inline bool compiler_starved() { return no_compiler || (starve && ((isr_calls++ / (BENCH_STARVE_ISRS)) & 1)); }
+  #endif
+
+  static inline uint64_t nanos() { return Clock::nanos(); }
+
+  static inline void add(const BenchSection s, const uint64_t ns) {
+    if (shadowing) return;
+    bench_section_t &sec = section[s];
+    sec.calls++;
+    sec.total_ns += ns;
+    NOLESS(sec.max_ns, ns);
+  }
+
+  // Fold the kernel counts of one recalculate() into the totals
+  static inline void end_replan() {
+    LOOP_L_N(k, BENCH_KERNEL_COUNT) {
+      kernel[k].total += kernel_run[k];
+      NOLESS(kernel[k].max, kernel_run[k]);
+      kernel_run[k] = 0;
+    }
+  }
+
+  #if ENABLED(VECTOR_JUNCTION_DEVIATION)
+    static inline void check_junction(const float vmax_junction_sqr, const float ref_vmax_junction_sqr) {
+      const float error = ABS(vmax_junction_sqr - ref_vmax_junction_sqr) / _MAX(ref_vmax_junction_sqr, 1e-6f);
+      junction.checked++;
+      if (error > BENCH_JUNCTION_TOLERANCE) junction.failed++;
+      NOLESS(junction.max_error, error);
+    }
+  #endif
+
+  #if ENABLED(INCREMENTAL_REPLANNING)
+    // The incremental and full replans must give the same block exactly
+    static inline void check_replan(const block_t &incremental, const block_t &full) {
+      replan.checked++;
+      if (incremental.entry_speed_sqr != full.entry_speed_sqr
+        || incremental.initial_rate != full.initial_rate
+        || incremental.final_rate != full.final_rate
+        || incremental.accelerate_until != full.accelerate_until
+        || incremental.decelerate_after != full.decelerate_after
+      ) replan.failed++;
+    }
+  #endif
+
+  static void reset();
+  static void record_step_interval(const hal_timer_t ticks);
+  static bool replay(const char * const path);
+  #if ENABLED(STEP_SEGMENT_QUEUE)
+    static bool replay_starved(const char * const path);
+    static bool replay_trickle(const char * const path);
+  #endif
+  static void report(const char * const path, const uint64_t elapsed_ns);
+  static int run(const int file_count, char * const files[]);
+
+private:
+  static bool skip_command(const char * const cmd);
+};
+
+// Time the enclosing scope into the given section
+class BenchScope {
+  const BenchSection s;
+  const uint64_t start_ns;
+public:
+  BenchScope(const BenchSection s) : s(s), start_ns(PlannerBenchmark::nanos()) {}
+  ~BenchScope() { PlannerBenchmark::add(s, PlannerBenchmark::nanos() - start_ns); }
+};
+
+#define BENCH_SCOPE(S) BenchScope _bench_scope(BENCH_##S)
+#define BENCH_KERNEL(K) do{ if (!PlannerBenchmark::shadowing) PlannerBenchmark::kernel_run[BENCH_KERNEL_##K]++; }while(0)
@@ -0,0 +1,199 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * step_segments.cpp - Segment compiler for STEP_SEGMENT_QUEUE
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(STEP_SEGMENT_QUEUE)
+
+#include "step_segments.h"
+#include "../module/planner.h"
+#include "../module/stepper.h"
+
+StepSegmentQueue step_segments;
+
+step_segment_t StepSegmentQueue::segments[STEP_SEGMENT_QUEUE_SIZE];
+volatile uint8_t StepSegmentQueue::head, StepSegmentQueue::tail;
+uint8_t StepSegmentQueue::running_index;
+uint32_t StepSegmentQueue::underruns;
+
+block_t* StepSegmentQueue::block;
+uint8_t StepSegmentQueue::block_index, StepSegmentQueue::oversampling;
+uint32_t StepSegmentQueue::events, StepSegmentQueue::event_count,
+         StepSegmentQueue::accelerate_until, StepSegmentQueue::decelerate_after,
+         StepSegmentQueue::phase_ticks, StepSegmentQueue::peak_rate;
+
+enum SegmentPhase : uint8_t { PHASE_ACCEL, PHASE_CRUISE, PHASE_DECEL, PHASE_NONE };
+static SegmentPhase phase;
+
+// Stepper timer ticks per segment
+constexpr uint32_t slice_ticks = (STEPPER_TIMER_RATE) / (STEP_SEGMENTS_PER_SECOND);
+
+#if ENABLED(S_CURVE_ACCELERATION)
+
+  // Rate on the 5th order Bézier curve from v0 to v1 (zero acceleration
+  // and jerk at both ends) at time t of a phase lasting 'duration' ticks.
+  static uint32_t bezier_rate(const uint32_t v0, const uint32_t v1, const uint32_t t, const uint32_t duration) {
+    if (t >= duration) return v1;
+    const float u = float(t) / duration;
+    return v0 + int32_t((int32_t(v1) - int32_t(v0)) * (u * u * u * (10.0f + u * (6.0f * u - 15.0f))));
+  }
+
+#endif
+
+void StepSegmentQueue::reset() {
+  head = tail = 0;
+  block = nullptr;
+}
+
+/**
+ * Freeze a block taken by the compiler. The Stepper ISR freezes blocks
+ * itself when the queue runs dry, so only do it if that hasn't happened.
+ */
+void StepSegmentQueue::freeze_block(const uint8_t index) {
+  const bool was_enabled = stepper.suspend();
+  if (planner.block_buffer_nonbusy == index) planner.freeze_nonbusy_block();
+  if (was_enabled) stepper.wake_up();
+}
+
+/**
+ * Set up the next planner block for compiling, skipping over
+ * (and handing to the Stepper ISR) any sync blocks on the way.
+ */
+bool StepSegmentQueue::take_block() {
+  for (;;) {
+    block_t * const b = planner.peek_nonbusy_block();
+    if (!b) return false;
+    const uint8_t index = b - planner.block_buffer;
+    if (!TEST(b->flag, BLOCK_BIT_SYNC_POSITION)) {
+      block = b;
+      block_index = index;
+      oversampling = TERN0(ADAPTIVE_STEP_SMOOTHING, Stepper::calc_oversampling(b->nominal_rate));
+      event_count = b->step_event_count << oversampling;
+      accelerate_until = b->accelerate_until << oversampling;
+      decelerate_after = b->decelerate_after << oversampling;
+      events = phase_ticks = 0;
+      peak_rate = b->initial_rate;
+      phase = PHASE_NONE;
+      return true;
+    }
+    freeze_block(index);
+  }
+}
+
+/**
+ * The step rate at time t of the current phase, worked out the same way
+ * as the Stepper ISR does it. The Bézier curve is only close, since the
+ * Stepper ISR evaluates it in fixed point.
+ */
+uint32_t StepSegmentQueue::phase_rate(const uint32_t t) {
+  switch (phase) {
+    case PHASE_ACCEL: {
+      #if ENABLED(S_CURVE_ACCELERATION)
+        return bezier_rate(block->initial_rate, block->cruise_rate, t, block->acceleration_time);
+      #else
+        const uint32_t rate = STEP_MULTIPLY(t, block->acceleration_rate) + block->initial_rate;
+        return _MIN(rate, block->nominal_rate);
+      #endif
+    }
+
+    case PHASE_CRUISE: return block->nominal_rate;
+
+    default: {
+      #if ENABLED(S_CURVE_ACCELERATION)
+        return bezier_rate(block->cruise_rate, block->final_rate, t, block->deceleration_time);
+      #else
+        const uint32_t dv = STEP_MULTIPLY(t, block->acceleration_rate);
+        return dv < peak_rate ? _MAX(peak_rate - dv, block->final_rate) : block->final_rate;
+      #endif
+    }
+  }
+}
+
+/**
+ * Add the next segment of the current block to the queue. The Stepper ISR
+ * takes the rate at the start of each call, so a segment uses the rate of
+ * its middle call. It ends early at a phase change, and a segment of one
+ * call gets the ISR's own interval.
+ */
+void StepSegmentQueue::compile_segment() {
+  step_segment_t &seg = segments[head];
+  seg.block_index = block_index;
+
+  if (!events) {
+    // The first call of a block runs at the initial rate, outside the phase times
+    seg.interval = Stepper::calc_timer_interval(block->initial_rate, &seg.steps_per_isr, oversampling);
+    events = _MIN(uint32_t(seg.steps_per_isr), event_count);
+  }
+  else {
+    const SegmentPhase p = events <= accelerate_until ? PHASE_ACCEL : events > decelerate_after ? PHASE_DECEL : PHASE_CRUISE;
+    if (p != phase) { phase = p; phase_ticks = 0; }
+
+    uint32_t phase_end = p == PHASE_ACCEL ? accelerate_until + 1 : p == PHASE_CRUISE ? decelerate_after + 1 : event_count;
+    NOMORE(phase_end, event_count);
+
+    // Estimate the calls in the slice from its middle, then take the rate of the middle call
+    uint8_t spi;
+    uint32_t interval = Stepper::calc_timer_interval(phase_rate(phase_ticks + slice_ticks / 2), &spi, oversampling),
+             calls = _MAX(slice_ticks / interval, 1UL);
+    interval = Stepper::calc_timer_interval(phase_rate(phase_ticks + (calls - 1) * interval / 2), &spi, oversampling);
+
+    // As many ISR calls as fit in the slice, without crossing into the next phase
+    calls = _MAX(slice_ticks / interval, 1UL);
+    NOMORE(calls, (phase_end - events + spi - 1) / spi);
+    phase_ticks += calls * interval;
+    events = _MIN(events + calls * spi, event_count);
+
+    // Deceleration starts from the rate of the last accelerating call
+    if (p == PHASE_ACCEL) peak_rate = phase_rate(phase_ticks - interval);
+
+    seg.interval = interval;
+    seg.steps_per_isr = spi;
+  }
+  seg.end_event = events;
+
+  head = SEGMENT_QUEUE_MOD(head + 1);
+
+  if (events >= event_count) block = nullptr;
+}
+
+void StepSegmentQueue::compile() {
+  while (SEGMENT_QUEUE_MOD(head + 1) != tail) {
+    // Drop the block if the Stepper ISR already discarded it
+    if (block && !planner.is_block_frozen(block_index)) block = nullptr;
+
+    if (block)
+      compile_segment();
+    else if (take_block()) {
+      // The Stepper ISR may start on the block once it's frozen, so give it a segment first
+      compile_segment();
+      freeze_block(block_index);
+    }
+    else
+      break;
+  }
+}
+
+#endif // STEP_SEGMENT_QUEUE
@@ -0,0 +1,123 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * step_segments.h - Step timing queue for STEP_SEGMENT_QUEUE
+ *
+ * The segment compiler runs in the main loop. It takes planner blocks once
+ * their plan is final (before block_buffer_planned), ahead of the Stepper
+ * ISR, and cuts their speed profile into short
+ * time slices, each with a precomputed timer interval and steps per ISR.
+ * The Stepper ISR only walks this queue, so it does no rate math at all.
+ *
+ * The queue has one producer (the main loop) and one consumer (the Stepper
+ * ISR). Each side only writes its own index, so no locking is needed.
+ *
+ * If the main loop stalls for longer than the queue lasts, or the next block
+ * may still be replanned, the Stepper ISR falls back to its own trapezoid
+ * math and takes the next block without waiting for the compiler. The move
+ * keeps its speed profile either way. The last blocks before the host goes
+ * quiet are never final, so they always run this way.
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "../module/planner.h"
+
+typedef struct {
+  uint32_t interval,        // Stepper timer ticks between ISR calls
+           end_event;       // Step event count of the block at the end of this segment
+  uint8_t steps_per_isr,    // Step events done by each ISR call
+          block_index;      // The planner block this segment belongs to
+} step_segment_t;
+
+#define SEGMENT_QUEUE_MOD(n) ((n) & ((STEP_SEGMENT_QUEUE_SIZE) - 1))
+
+class StepSegmentQueue {
+  public:
+
+    static step_segment_t segments[STEP_SEGMENT_QUEUE_SIZE];
+    static volatile uint8_t head, tail;   // Written by the compiler and the Stepper ISR respectively
+    static uint32_t underruns;            // ISR calls that found no segment for the next step events
+
+    // Compile segments until the queue is full or no block is ready (main loop)
+    static void compile();
+
+    // Drop all segments and the block being compiled (with the Stepper ISR suspended)
+    static void reset();
+
+    // Skip leftover segments of a discarded block (Stepper ISR)
+    FORCE_INLINE static void start_block(const uint8_t block_index) {
+      running_index = block_index;
+      uint8_t t = tail;
+      while (t != head && segments[t].block_index != block_index) t = SEGMENT_QUEUE_MOD(t + 1);
+      tail = t;
+    }
+
+    /**
+     * Get the timer interval and steps per ISR for the next step events (Stepper ISR).
+     * If the compiler fell behind, count an underrun and return false, so the
+     * Stepper ISR works out the rate from the block itself.
+     */
+    FORCE_INLINE static bool next_interval(const uint32_t events_completed, uint32_t &interval, uint8_t &steps_per_isr) {
+      uint8_t t = tail;
+      while (t != head) {
+        const step_segment_t &seg = segments[t];
+        // Segments of the next block may arrive while this one runs without any
+        if (seg.block_index != running_index) break;
+        if (events_completed < seg.end_event) {
+          tail = t;
+          steps_per_isr = seg.steps_per_isr;
+          interval = seg.interval;
+          return true;
+        }
+        // Don't run into the segments of the next block
+        const uint8_t n = SEGMENT_QUEUE_MOD(t + 1);
+        if (n == head || segments[n].block_index != seg.block_index) break;
+        t = n;
+      }
+      tail = t;
+      underruns++;
+      return false;
+    }
+
+  private:
+
+    static uint8_t running_index;         // The block the Stepper ISR is running
+
+    // State of the block being compiled
+    static block_t *block;
+    static uint8_t block_index, oversampling;
+    static uint32_t events,               // Step events covered by the segments so far
+                    event_count,          // Step events of the block, scaled for oversampling
+                    accelerate_until,
+                    decelerate_after,
+                    phase_ticks,          // Time spent in the current phase
+                    peak_rate;            // Step rate of the last accelerating ISR call
+
+    static bool take_block();
+    static void freeze_block(const uint8_t index);
+    static uint32_t phase_rate(const uint32_t t);
+    static void compile_segment();
+};
+
+extern StepSegmentQueue step_segments;
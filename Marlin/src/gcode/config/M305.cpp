@@ -27,6 +27,37 @@
 #include "../gcode.h"
 #include "../../module/temperature.h"
 
+#if ENABLED(FAST_USER_THERMISTORS)
+
+  #include "../../MarlinCore.h" // for idle()
+
+  /**
+   * Compare the table with the formula at every raw reading
+   * and report the largest difference.
+   */
+  static void report_user_thermistor_table(const uint8_t t_index) {
+    while (TEST(thermalManager.user_thermistor_tables_pending, t_index)) idle(); // Let the table build finish
+    const int adc_max = MAX_RAW_THERMISTOR_VALUE;
+    float max_error = 0;
+    int16_t max_raw = 0;
+    for (int32_t raw = 0; raw <= adc_max; raw++) {
+      const float celsius = thermalManager.user_thermistor_formula(t_index, raw),
+                  error = ABS(thermalManager.user_thermistor_to_deg_c(t_index, raw) - celsius);
+      if (celsius > THERMISTOR_ABS_ZERO_C && error > max_error) { max_error = error; max_raw = raw; } // The table holds 999 past the top of the curve
+      if (!(raw & 0xFF)) idle();
+    }
+    SERIAL_ECHO_START();
+    SERIAL_CHAR('P');
+    SERIAL_CHAR('0' + t_index);
+    SERIAL_ECHOPAIR(" table ", int(thermalManager.user_thermistor_table[t_index].len), " entries, max error ");
+    SERIAL_ECHO_F(max_error, 3);
+    SERIAL_ECHOPAIR("C at raw ", max_raw, " (");
+    SERIAL_ECHO_F(thermalManager.user_thermistor_formula(t_index, max_raw), 1);
+    SERIAL_ECHOLNPGM("C)");
+  }
+
+#endif
+
 /**
  * M305: Set (or report) custom thermistor parameters
  *
@@ -35,6 +66,7 @@
  *   T[ohms]   Resistance at 25C
  *   B[beta]   Thermistor "beta" value
  *   C[coeff]  Steinhart-Hart Coefficient 'C'
+ *   E         Report the table's maximum error against the formula (Requires FAST_USER_THERMISTORS)
  *
  *   Format: M305 P[tbl_index] R[pullup_resistor_val] T[therm_25C_resistance] B[therm_beta] C[Steinhart_Hart_C_coeff]
  *
@@ -43,6 +75,7 @@
  *           M305 P0 T100000
  *           M305 P0 B3950
  *           M305 P0 C0.0
+ *           M305 P0 E
  */
 void GcodeSuite::M305() {
   const int8_t t_index = parser.intval('P', -1);
@@ -69,7 +102,18 @@ void GcodeSuite::M305() {
     if (parser.seen('C')) // Steinhart-Hart C coefficient
       if (!thermalManager.set_sh_coeff(t_index, parser.value_float()))
         SERIAL_ECHO_MSG("!Invalid Steinhart-Hart C coeff. (-0.01 < C < +0.01)");
-  }                       // If not setting then report parameters
+
+    thermalManager.update_user_thermistor(t_index);
+  }
+  #if ENABLED(FAST_USER_THERMISTORS)
+    else if (parser.seen('E')) { // Report the table error
+      if (t_index < 0)           // ...of all user thermistors
+        LOOP_L_N(i, USER_THERMISTORS) report_user_thermistor_table(i);
+      else                       // ...of one user thermistor
+        report_user_thermistor_table(t_index);
+    }
+  #endif
+                          // If not setting then report parameters
   else if (t_index < 0) { // ...all user thermistors
     LOOP_L_N(i, USER_THERMISTORS)
       thermalManager.log_user_thermistor(i);
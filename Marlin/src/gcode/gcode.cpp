@@ -59,6 +59,27 @@ GcodeSuite gcode;
 
 #include "../MarlinCore.h" // for idle()
 
+#if ENABLED(SD_GCODE_CACHE)
+  #include "../sd/gcode_cache.h"
+  static char *token_cmd; // The current queue command, if it's a token record
+#endif
+
+#if ENABLED(BINARY_MOTION_PROTOCOL)
+  #include "../feature/binary_motion.h"
+  static char *move_cmd;  // The current queue command, if it's a binary move
+#endif
+
+// Parse a command, which may be a pre-parsed record from the SD cache or a binary move
+inline void parse_command(char * const cmd) {
+  #if ENABLED(SD_GCODE_CACHE)
+    if (cmd == token_cmd) return gcode_cache.load(cmd);
+  #endif
+  #if ENABLED(BINARY_MOTION_PROTOCOL)
+    if (cmd == move_cmd) return BinaryMotionProtocol::load(cmd);
+  #endif
+  parser.parse(cmd);
+}
+
 // Inactivity shutdown
 millis_t GcodeSuite::previous_move_ms = 0,
          GcodeSuite::max_inactive_time = 0,
@@ -434,6 +455,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
           case 34: M34(); break;                                  // M34: Set SD card sorting options
         #endif
 
+        #if ENABLED(SD_GCODE_CACHE)
+          case 36: M36(); break;                                  // M36: Pre-parse an SD file
+        #endif
+
         case 928: M928(); break;                                  // M928: Start SD write
       #endif // SDSUPPORT
 
@@ -544,6 +569,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
       case 120: M120(); break;                                    // M120: Enable endstops
       case 121: M121(); break;                                    // M121: Disable endstops
 
+      #if ENABLED(ISR_PROFILER)
+        case 124: M124(); break;                                  // M124: Report ISR cycles
+      #endif
+
       #if PREHEAT_COUNT
         case 145: M145(); break;                                  // M145: Set material heatup parameters
       #endif
@@ -663,6 +692,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 305: M305(); break;                                  // M305: Set user thermistor parameters
       #endif
 
+      #if ENABLED(MPCTEMP)
+        case 306: M306(); break;                                  // M306: MPC settings and autotune
+      #endif
+
       #if ENABLED(REPETIER_GCODE_M360)
         case 360: M360(); break;                                  // M360: Firmware settings
       #endif
@@ -748,6 +781,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 575: M575(); break;                                  // M575: Set serial baudrate
       #endif
 
+      #if ENABLED(WINDOWED_OK)
+        case 576: M576(); break;                                  // M576: Set windowed "ok"
+      #endif
+
       #if ENABLED(ADVANCED_PAUSE_FEATURE)
         case 600: M600(); break;                                  // M600: Pause for Filament Change
         case 603: M603(); break;                                  // M603: Configure Filament Change
@@ -911,7 +948,7 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
  * This is called from the main loop()
  */
 void GcodeSuite::process_next_command() {
-  char * const current_command = queue.command_buffer[queue.index_r];
+  char * const current_command = queue.current_command();
 
   PORT_REDIRECT(queue.port[queue.index_r]);
 
@@ -919,17 +956,35 @@ void GcodeSuite::process_next_command() {
     recovery.queue_index_r = queue.index_r;
   #endif
 
+  TERN_(SD_GCODE_CACHE, token_cmd = queue.command_is_token() ? current_command : nullptr);
+  TERN_(BINARY_MOTION_PROTOCOL, move_cmd = queue.command_is_move() ? current_command : nullptr);
+
   if (DEBUGGING(ECHO)) {
     SERIAL_ECHO_START();
-    SERIAL_ECHOLN(current_command);
+    #if ENABLED(SD_GCODE_CACHE)
+      if (token_cmd) {
+        SERIAL_ECHOPAIR("(cached) ", token_cmd[1]);
+        SERIAL_ECHOLN(uint16_t(uint8_t(token_cmd[2]) | (uint8_t(token_cmd[3]) << 8)));
+      }
+      else
+    #endif
+    #if ENABLED(BINARY_MOTION_PROTOCOL)
+      if (move_cmd) SERIAL_ECHOLNPAIR("(binary) G", uint8_t(move_cmd[0]) >> 6);
+      else
+    #endif
+        SERIAL_ECHOLN(current_command);
     #if ENABLED(M100_FREE_MEMORY_DUMPER)
       SERIAL_ECHOPAIR("slot:", queue.index_r);
-      M100_dump_routine(PSTR("   Command Queue:"), &queue.command_buffer[0][0], &queue.command_buffer[BUFSIZE - 1][MAX_CMD_SIZE - 1]);
+      #if ENABLED(COMMAND_RING_BUFFER)
+        M100_dump_routine(PSTR("   Command Queue:"), &queue.ring[0], &queue.ring[COMMAND_RING_BYTES - 1]);
+      #else
+        M100_dump_routine(PSTR("   Command Queue:"), &queue.command_buffer[0][0], &queue.command_buffer[BUFSIZE - 1][MAX_CMD_SIZE - 1]);
+      #endif
     #endif
   }
 
   // Parse the next command in the queue
-  parser.parse(current_command);
+  parse_command(current_command);
   process_parsed_command();
 }
 
@@ -951,7 +1006,7 @@ void GcodeSuite::process_subcommands_now_P(PGM_P pgcode) {
     if (!delim) break;                                // Last command?
     pgcode = delim + 1;                               // Get the next command
   }
-  parser.parse(saved_cmd);                            // Restore the parser state
+  parse_command(saved_cmd);                           // Restore the parser state
 }
 
 void GcodeSuite::process_subcommands_now(char * gcode) {
@@ -965,7 +1020,7 @@ void GcodeSuite::process_subcommands_now(char * gcode) {
     if (!delim) break;                                // Last command?
     gcode = delim + 1;                                // Get the next command
   }
-  parser.parse(saved_cmd);                            // Restore the parser state
+  parse_command(saved_cmd);                           // Restore the parser state
 }
 
 #if ENABLED(HOST_KEEPALIVE_FEATURE)
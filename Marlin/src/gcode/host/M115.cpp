@@ -96,6 +96,9 @@ void GcodeSuite::M115() {
     cap_line(PSTR("TOGGLE_LIGHTS"), ENABLED(HAS_CASE_LIGHT));
     cap_line(PSTR("CASE_LIGHT_BRIGHTNESS"), TERN0(HAS_CASE_LIGHT, PWM_PIN(CASE_LIGHT_PIN)));
 
+    // WINDOWED_OK (M576)
+    cap_line(PSTR("WINDOWED_OK"), ENABLED(WINDOWED_OK));
+
     // EMERGENCY_PARSER (M108, M112, M410, M876)
     cap_line(PSTR("EMERGENCY_PARSER"), ENABLED(EMERGENCY_PARSER));
 
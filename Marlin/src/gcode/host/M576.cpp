@@ -19,31 +19,26 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  *
  */
-#ifdef __PLAT_LINUX__
 
-#include "IOLoggerCSV.h"
 
-IOLoggerCSV::IOLoggerCSV(std::string filename) {
-  file.open(filename);
-}
+#include "../../inc/MarlinConfig.h"
 
-IOLoggerCSV::~IOLoggerCSV() {
-  file.close();
-}
+#if ENABLED(WINDOWED_OK)
 
-void IOLoggerCSV::log(GpioEvent ev) {
-  std::lock_guard<std::mutex> lock(vector_lock);
-  events.push_back(ev); //minimal impact to signal handler
-}
+#include "../gcode.h"
+#include "../queue.h"
 
-void IOLoggerCSV::flush() {
-  { std::lock_guard<std::mutex> lock(vector_lock);
-    while (!events.empty()) {
-      file << events.front().timestamp << ", "<< events.front().pin_id << ", " << events.front().event << std::endl;
-      events.pop_front();
-    }
-  }
-  file.flush();
+/**
+ * M576: Windowed "ok" for the serial port that sent the command
+ *
+ *   S<bool> 1 (default) to reply with "ok W<lines> R<bytes>" and then
+ *           return credits in batches, 0 to go back to one "ok" per line.
+ */
+void GcodeSuite::M576() {
+  const int16_t pn = queue.command_port();
+  if (pn < 0) return;
+  queue.windowed_ok[pn] = !parser.seen('S') || parser.value_bool();
+  if (queue.windowed_ok[pn]) queue.send_window(pn);
 }
 
-#endif // __PLAT_LINUX__
+#endif // WINDOWED_OK
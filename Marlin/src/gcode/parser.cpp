@@ -32,6 +32,10 @@
   #include "queue.h"
 #endif
 
+#if ENABLED(SD_GCODE_CACHE)
+  #include "../sd/gcode_cache.h"
+#endif
+
 // Must be declared for allocation and to satisfy the linker
 // Zero values need no initialization.
 
@@ -66,6 +70,12 @@ int GCodeParser::codenum;
   // Optimized Parameters
   uint32_t GCodeParser::codebits;  // found bits
   uint8_t GCodeParser::param[26];  // parameter offsets from command_ptr
+  #if ENABLED(FASTER_GCODE_VALUES)
+    uint32_t GCodeParser::valbits;  // parameters with values
+    float GCodeParser::fvalue[26];  // parameter values
+    uint8_t GCodeParser::value_ind;
+    char GCodeParser::no_text[1];   // "" for values with no text
+  #endif
 #else
   char *GCodeParser::command_args; // start of parameters
 #endif
@@ -90,6 +100,75 @@ void GCodeParser::reset() {
   #endif
 }
 
+#if ENABLED(FASTER_GCODE_VALUES)
+
+  /**
+   * Read [-+]?[0-9]*.?[0-9]* like strtof, stopping at 'E' as value_float does.
+   * Up to 9 significant digits are gathered into an integer with a decimal
+   * exponent, so decoding takes only one conversion and one scale.
+   * A value with 7 or fewer significant digits is exact to the last bit.
+   * Return the exponent.
+   */
+  int8_t GCodeParser::read_fixed(const char *p, int32_t &mant) {
+    const bool neg = *p == '-';
+    if (neg || *p == '+') ++p;
+
+    uint32_t m = 0;
+    int8_t exp10 = 0, digits = 0;
+    bool frac = false;
+    for (;; ++p) {
+      const char c = *p;
+      if (NUMERIC(c)) {
+        if (digits < 9) {
+          m = m * 10 + (c - '0');
+          if (m) ++digits;                    // Leading zeros are not significant
+          if (frac && exp10 > -127) --exp10;
+        }
+        else if (!frac && exp10 < 38)         // Integer digits past the 9th only scale
+          ++exp10;
+      }
+      else if (c == '.' && !frac)
+        frac = true;
+      else
+        break;
+    }
+
+    mant = neg ? -int32_t(m) : int32_t(m);
+    return exp10;
+  }
+
+  float GCodeParser::fixed_to_float(const int32_t mant, int8_t exp10) {
+    static const float pow10[] PROGMEM = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+    float f = mant < 0 ? -mant : mant;
+    for (; exp10 < -10; exp10 += 10) f /= 1e10f;
+    for (; exp10 > 10; exp10 -= 10) f *= 1e10f;
+    if (exp10 < 0)
+      f /= pgm_read_float(&pow10[-exp10]);
+    else if (exp10 > 0)
+      f *= pgm_read_float(&pow10[exp10]);
+
+    return mant < 0 ? -f : f;
+  }
+
+  void GCodeParser::set_command(const char letter, const int code, const uint8_t sub/*=0*/) {
+    reset();
+    command_ptr = no_text;
+    command_letter = letter;
+    codenum = code;
+    TERN_(USE_GCODE_SUBCODES, subcode = sub);
+    UNUSED(sub);
+    #if ENABLED(GCODE_MOTION_MODES)
+      // Keep the motion mode for G-code that follows, as parse() does
+      if (letter == 'G' && (code <= TERN(ARC_SUPPORT, 3, 1) || code == 5 || TERN0(G38_PROBE_TARGET, code == 38))) {
+        motion_mode_codenum = code;
+        TERN_(USE_GCODE_SUBCODES, motion_mode_subcode = sub);
+      }
+    #endif
+  }
+
+#endif
+
 #if ENABLED(GCODE_QUOTED_STRINGS)
 
   // Pass the address after the first quote (if any)
@@ -247,6 +326,9 @@ void GCodeParser::parse(char *p) {
     #if ENABLED(EXPECTED_PRINTER_CHECK)
       case 16:
     #endif
+    #if ENABLED(SD_GCODE_CACHE)
+      case 36:
+    #endif
     case 23: case 28: case 30: case 117: case 118: case 928:
       string_arg = unescape_string(p);
       return;
@@ -361,6 +443,15 @@ void GCodeParser::parse(char *p) {
 #endif // CNC_COORDINATE_SYSTEMS
 
 void GCodeParser::unknown_command_warning() {
+  #if ENABLED(SD_GCODE_CACHE)
+    if (*command_ptr == GCODE_TOKEN_MARK) {   // Pre-parsed SD command
+      SERIAL_ECHO_START();
+      SERIAL_ECHOPAIR(STR_UNKNOWN_COMMAND, command_letter);
+      SERIAL_ECHO(codenum);
+      SERIAL_ECHOLNPGM("\"");
+      return;
+    }
+  #endif
   SERIAL_ECHO_MSG(STR_UNKNOWN_COMMAND, command_ptr, "\"");
 }
 
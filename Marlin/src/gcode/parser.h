@@ -49,6 +49,8 @@
  *  - FASTER_GCODE_PARSER:
  *    - Flags existing params (1 bit each)
  *    - Stores value offsets (1 byte each)
+ *  - FASTER_GCODE_VALUES:
+ *    - Decodes numeric values while parsing, without strtof (1 float each)
  *  - Provide accessors for parameters:
  *    - Parameter exists
  *    - Parameter has value
@@ -62,6 +64,17 @@ private:
   #if ENABLED(FASTER_GCODE_PARSER)
     static uint32_t codebits;       // Parameters pre-scanned
     static uint8_t param[26];       // For A-Z, offsets into command args
+    #if ENABLED(FASTER_GCODE_VALUES)
+      static uint32_t valbits;      // Parameters with a numeric value
+      static float fvalue[26];      // For A-Z, values decoded by parse
+      static uint8_t value_ind;     // Set by seen, the parameter value_float reads
+      static char no_text[1];       // The value_ptr of a value set by set_value
+      static inline float decode_float(const char *p) {
+        int32_t mant;
+        const int8_t exp10 = read_fixed(p, mant);
+        return fixed_to_float(mant, exp10);
+      }
+    #endif
   #else
     static char *command_args;      // Args start here, for slow scan
   #endif
@@ -126,6 +139,13 @@ public:
       if (ind >= COUNT(param)) return;           // Only A-Z
       SBI32(codebits, ind);                      // parameter exists
       param[ind] = ptr ? ptr - command_ptr : 0;  // parameter offset or 0
+      #if ENABLED(FASTER_GCODE_VALUES)
+        if (ptr && valid_float(ptr)) {
+          SBI32(valbits, ind);
+          fvalue[ind] = decode_float(ptr); // Decode now, so value_float is a load
+        }
+        else CBI32(valbits, ind);
+      #endif
       #if ENABLED(DEBUG_GCODE_PARSER)
         if (codenum == 800) {
           SERIAL_ECHOPAIR("Set bit ", (int)ind, " of codebits (", hex_address((void*)(codebits >> 16)));
@@ -142,8 +162,14 @@ public:
       if (ind >= COUNT(param)) return false; // Only A-Z
       const bool b = TEST32(codebits, ind);
       if (b) {
-        char * const ptr = command_ptr + param[ind];
-        value_ptr = param[ind] && valid_float(ptr) ? ptr : nullptr;
+        #if ENABLED(FASTER_GCODE_VALUES)
+          // A value from set_value has no text (param 0) wherever command_ptr points
+          value_ptr = TEST32(valbits, ind) ? (param[ind] ? command_ptr + param[ind] : no_text) : nullptr;
+          value_ind = ind;
+        #else
+          char * const ptr = command_ptr + param[ind];
+          value_ptr = param[ind] && valid_float(ptr) ? ptr : nullptr;
+        #endif
       }
       return b;
     }
@@ -178,6 +204,32 @@ public:
 
     FORCE_INLINE static bool seen_test(const char c) { return TEST32(codebits, LETTER_BIT(c)); }
 
+    #if ENABLED(FASTER_GCODE_VALUES)
+      // A value as up to 9 significant digits and a power of 10, as decode_float reads it
+      static int8_t read_fixed(const char *p, int32_t &mant);
+      static float fixed_to_float(const int32_t mant, int8_t exp10);
+
+      /**
+       * Build a command from values that arrive already decoded, as from
+       * a binary protocol. There is no text, so value_string() is empty and
+       * value_long() truncates the float value, as strtol does the text.
+       */
+      static void set_command(const char letter, const int code, const uint8_t sub=0);
+      static inline void set_value(const char c, const float v) {
+        const uint8_t ind = LETTER_BIT(c);
+        SBI32(codebits, ind);
+        SBI32(valbits, ind);
+        param[ind] = 0;
+        fvalue[ind] = v;
+      }
+      static inline void set_flag(const char c) {   // A parameter with no value
+        const uint8_t ind = LETTER_BIT(c);
+        SBI32(codebits, ind);
+        CBI32(valbits, ind);
+        param[ind] = 0;
+      }
+    #endif
+
   #else // !FASTER_GCODE_PARSER
 
     #if ENABLED(GCODE_CASE_INSENSITIVE)
@@ -246,27 +298,37 @@ public:
 
   // Float removes 'E' to prevent scientific notation interpretation
   static inline float value_float() {
-    if (value_ptr) {
-      char *e = value_ptr;
-      for (;;) {
-        const char c = *e;
-        if (c == '\0' || c == ' ') break;
-        if (c == 'E' || c == 'e') {
-          *e = '\0';
-          const float ret = strtof(value_ptr, nullptr);
-          *e = c;
-          return ret;
+    #if ENABLED(FASTER_GCODE_VALUES)
+      return value_ptr ? fvalue[value_ind] : 0;
+    #else
+      if (value_ptr) {
+        char *e = value_ptr;
+        for (;;) {
+          const char c = *e;
+          if (c == '\0' || c == ' ') break;
+          if (c == 'E' || c == 'e') {
+            *e = '\0';
+            const float ret = strtof(value_ptr, nullptr);
+            *e = c;
+            return ret;
+          }
+          ++e;
         }
-        ++e;
+        return strtof(value_ptr, nullptr);
       }
-      return strtof(value_ptr, nullptr);
-    }
-    return 0;
+      return 0;
+    #endif
   }
 
   // Code value as a long or ulong
-  static inline int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
-  static inline uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+  #if ENABLED(FASTER_GCODE_VALUES)
+    // A value set with no text is taken from the float
+    static inline int32_t value_long() { return value_ptr ? (*value_ptr ? strtol(value_ptr, nullptr, 10) : int32_t(value_float())) : 0L; }
+    static inline uint32_t value_ulong() { return value_ptr ? (*value_ptr ? strtoul(value_ptr, nullptr, 10) : uint32_t(int32_t(value_float()))) : 0UL; }
+  #else
+    static inline int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
+    static inline uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+  #endif
 
   // Code value for use as time
   static inline millis_t value_millis() { return value_ulong(); }
@@ -47,6 +47,10 @@ GCodeQueue queue;
   #include "../feature/powerloss.h"
 #endif
 
+#if BOTH(SERIAL_FAIR_INTAKE, EMERGENCY_PARSER)
+  #include "../feature/e_parser.h"
+#endif
+
 /**
  * GCode line number handling. Hosts may opt to include line numbers when
  * sending commands to Marlin, and lines will be checked for sequentiality.
@@ -67,7 +71,12 @@ uint8_t GCodeQueue::length = 0,  // Count of commands in the queue
         GCodeQueue::index_r = 0, // Ring buffer read position
         GCodeQueue::index_w = 0; // Ring buffer write position
 
-char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
+#if ENABLED(COMMAND_RING_BUFFER)
+  char GCodeQueue::ring[COMMAND_RING_BYTES];
+  uint16_t GCodeQueue::ring_r, GCodeQueue::ring_w;
+#else
+  char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
+#endif
 
 /*
  * The port that the command was received on
@@ -76,6 +85,14 @@ char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
   int16_t GCodeQueue::port[BUFSIZE];
 #endif
 
+#if ENABLED(SD_GCODE_CACHE)
+  bool GCodeQueue::token[BUFSIZE];
+#endif
+
+#if ENABLED(BINARY_MOTION_PROTOCOL)
+  bool GCodeQueue::move[BUFSIZE];
+#endif
+
 /**
  * Serial command injection
  */
@@ -85,6 +102,27 @@ static int serial_count[NUM_SERIAL] = { 0 };
 
 bool send_ok[BUFSIZE];
 
+#if ENABLED(WINDOWED_OK)
+  bool GCodeQueue::windowed_ok[NUM_SERIAL]; // = { false }
+  uint8_t GCodeQueue::credit_lines[NUM_SERIAL];
+  uint16_t GCodeQueue::credit_bytes[NUM_SERIAL];
+
+  // Bytes the host may have in flight. USB-native boards have no RX_BUFFER_SIZE.
+  #if RX_BUFFER_SIZE >= 2
+    #define RX_WINDOW (RX_BUFFER_SIZE - 1)
+  #else
+    #define RX_WINDOW MAX_CMD_SIZE
+  #endif
+#endif
+
+#if ENABLED(SERIAL_FAIR_INTAKE)
+  uint8_t GCodeQueue::port_queued[NUM_SERIAL]; // = { 0 }
+
+  // Each port's share of the queue, at least one slot
+  constexpr uint8_t port_weight[NUM_SERIAL] = SERIAL_PORT_WEIGHTS;
+  #define PORT_SHARE(P) _MAX(1, (BUFSIZE) * port_weight[P] / (port_weight[0] + port_weight[1]))
+#endif
+
 /**
  * Next Injected PROGMEM Command pointer. (nullptr == empty)
  * Internal commands are enqueued ahead of serial / SD commands.
@@ -113,8 +151,77 @@ bool GCodeQueue::has_commands_queued() {
  */
 void GCodeQueue::clear() {
   index_r = index_w = length = 0;
+  TERN_(SERIAL_FAIR_INTAKE, ZERO(port_queued));
+  TERN_(COMMAND_RING_BUFFER, ring_r = ring_w); // Keep the line being received
 }
 
+#if ENABLED(COMMAND_RING_BUFFER)
+
+  /**
+   * Bytes at ring_w held by the line the first serial port is receiving.
+   * A binary file transfer uses the whole line as its packet buffer.
+   */
+  uint16_t GCodeQueue::open_bytes() {
+    #if ENABLED(BINARY_FILE_TRANSFER)
+      if (card.flag.binary_mode && card.transfer_port_index == 0) return MAX_CMD_SIZE + 1;
+    #endif
+    return serial_count[0] ? serial_count[0] + 1 : 0;
+  }
+
+  /**
+   * Make 'bytes' of contiguous space at ring_w, counting the line being
+   * received there. If the end of the ring is too short, move that line to
+   * the start and mark the end unused. Return false if the ring is too full.
+   */
+  bool GCodeQueue::make_room(const uint16_t bytes) {
+    const uint16_t open = open_bytes();
+    if (!length && !open) ring_w = 0;                 // Empty, so start over
+    if (length && ring_w <= ring_r) return ring_r - ring_w >= bytes;
+    if (COMMAND_RING_BYTES - ring_w >= bytes) return true;
+    if ((length ? ring_r : COMMAND_RING_BYTES) < bytes) return false;
+    if (open) memmove(ring, &ring[ring_w], open);
+    if (length && ring_w < COMMAND_RING_BYTES)        // (ring_w > open, since COMMAND_RING_BYTES >= 4 * MAX_CMD_SIZE)
+      ring[ring_w] = RING_WRAP;
+    ring_w = 0;
+    return true;
+  }
+
+  /**
+   * Get room for a whole line of up to 'len' chars. It goes after the line the
+   * first serial port is receiving, and commit_line moves it in front.
+   * Return nullptr if the ring is too full.
+   */
+  char* GCodeQueue::new_line(const uint8_t len) {
+    if (!make_room((open_bytes() ? MAX_CMD_SIZE + 1 : 0) + len + 2)) return nullptr;
+    return &ring[ring_w + open_bytes() + 1];
+  }
+
+  // Reverse the bytes from a up to b
+  static inline void reverse_bytes(char *a, char *b) {
+    while (a < --b) { const char c = *a; *a++ = *b; *b = c; }
+  }
+
+  /**
+   * Complete the line of 'len' chars starting 'skip' bytes after ring_w.
+   * A line placed after the line being received is rotated in front of it.
+   * Call _commit_command after this.
+   */
+  void GCodeQueue::commit_line(const uint8_t len, const uint16_t skip) {
+    char * const rec = &ring[ring_w];
+    const uint16_t size = len + 2;
+    rec[skip] = len;
+    rec[skip + 1 + len] = '\0';
+    if (skip) {
+      reverse_bytes(rec, rec + skip);
+      reverse_bytes(rec + skip, rec + skip + size);
+      reverse_bytes(rec, rec + skip + size);
+    }
+    if (!length) ring_r = ring_w;
+    ring_w += size;
+  }
+
+#endif // COMMAND_RING_BUFFER
+
 /**
  * Once a new command is in the ring buffer, call this to commit it
  */
@@ -124,7 +231,10 @@ void GCodeQueue::_commit_command(bool say_ok
   #endif
 ) {
   send_ok[index_w] = say_ok;
+  TERN_(SD_GCODE_CACHE, token[index_w] = false);
+  TERN_(BINARY_MOTION_PROTOCOL, move[index_w] = false);
   TERN_(HAS_MULTI_SERIAL, port[index_w] = p);
+  TERN_(SERIAL_FAIR_INTAKE, if (p >= 0) port_queued[p]++);
   TERN_(POWER_LOSS_RECOVERY, recovery.commit_sdpos(index_w));
   if (++index_w >= BUFSIZE) index_w = 0;
   length++;
@@ -141,7 +251,15 @@ bool GCodeQueue::_enqueue(const char* cmd, bool say_ok/*=false*/
   #endif
 ) {
   if (*cmd == ';' || length >= BUFSIZE) return false;
-  strcpy(command_buffer[index_w], cmd);
+  #if ENABLED(COMMAND_RING_BUFFER)
+    const uint8_t len = _MIN(strlen(cmd), size_t(MAX_CMD_SIZE - 1));
+    char * const line = new_line(len);
+    if (!line) return false;
+    memcpy(line, cmd, len);
+    commit_line(len, open_bytes());
+  #else
+    strcpy(command_buffer[index_w], cmd);
+  #endif
   _commit_command(say_ok
     #if HAS_MULTI_SERIAL
       , pn
@@ -150,6 +268,34 @@ bool GCodeQueue::_enqueue(const char* cmd, bool say_ok/*=false*/
   return true;
 }
 
+#if ENABLED(BINARY_MOTION_PROTOCOL)
+
+  /**
+   * Add a decoded binary move to the queue, with no "ok".
+   * The record may contain nul bytes, so it's copied by length.
+   */
+  bool GCodeQueue::enqueue_move(const char * const rec, const uint8_t len) {
+    if (length >= BUFSIZE) return false;
+    #if ENABLED(COMMAND_RING_BUFFER)
+      char * const line = new_line(len);
+      if (!line) return false;
+      memcpy(line, rec, len);
+      commit_line(len, open_bytes());
+    #else
+      memcpy(command_buffer[index_w], rec, len);
+    #endif
+    const uint8_t w = index_w;
+    _commit_command(false
+      #if HAS_MULTI_SERIAL
+        , card.transfer_port_index
+      #endif
+    );
+    move[w] = true;
+    return true;
+  }
+
+#endif
+
 #define ISEOL(C) ((C) == '\n' || (C) == '\r')
 
 /**
@@ -280,9 +426,13 @@ void GCodeQueue::ok_to_send() {
     PORT_REDIRECT(pn);                    // Reply to the serial port that sent the command
   #endif
   if (!send_ok[index_r]) return;
+  #if ENABLED(WINDOWED_OK)
+    const uint8_t cp = command_port();
+    if (windowed_ok[cp]) { credit_lines[cp]++; return; } // Sent in a batch by get_serial_commands
+  #endif
   SERIAL_ECHOPGM(STR_OK);
   #if ENABLED(ADVANCED_OK)
-    char* p = command_buffer[index_r];
+    char* p = current_command();
     if (*p == 'N') {
       SERIAL_ECHO(' ');
       SERIAL_ECHO(*p++);
@@ -308,6 +458,9 @@ void GCodeQueue::flush_and_request_resend() {
   SERIAL_FLUSH();
   SERIAL_ECHOPGM(STR_RESEND);
   SERIAL_ECHOLN(last_N[pn] + 1);
+  #if ENABLED(WINDOWED_OK)
+    if (windowed_ok[pn]) return send_window(pn); // The host starts over with a new window
+  #endif
   ok_to_send();
 }
 
@@ -325,6 +478,96 @@ inline int read_serial(const uint8_t index) {
   }
 }
 
+#if EITHER(WINDOWED_OK, SERIAL_FAIR_INTAKE)
+
+  inline int serial_bytes_waiting(const uint8_t index) {
+    switch (index) {
+      case 0: return MYSERIAL0.available();
+      #if HAS_MULTI_SERIAL
+        case 1: return MYSERIAL1.available();
+      #endif
+      default: return 0;
+    }
+  }
+
+#endif
+
+#if ENABLED(WINDOWED_OK)
+
+  /**
+   * Grant the whole window: the free command slots and RX bytes.
+   * Commands still in the queue are credited as they finish.
+   */
+  void GCodeQueue::send_window(const uint8_t pn) {
+    PORT_REDIRECT(pn);
+    SERIAL_ECHOPGM(STR_OK);
+    SERIAL_ECHOLNPAIR(" W", int(BUFSIZE - length), " R", int(RX_WINDOW - serial_bytes_waiting(pn)));
+    credit_lines[pn] = credit_bytes[pn] = 0;
+  }
+
+  // Return the lines done and bytes read since the last grant
+  void GCodeQueue::send_credits(const uint8_t pn) {
+    PORT_REDIRECT(pn);
+    SERIAL_ECHOPGM(STR_OK);
+    SERIAL_ECHOLNPAIR(" C", int(credit_lines[pn]), " R", credit_bytes[pn]);
+    credit_lines[pn] = credit_bytes[pn] = 0;
+  }
+
+#endif
+
+#if ENABLED(SERIAL_FAIR_INTAKE)
+
+  /**
+   * A port may queue commands up to its share. Past that it may only take
+   * free slots that no other port with input waiting is owed.
+   */
+  bool GCodeQueue::port_may_queue(const uint8_t pn) {
+    if (length >= BUFSIZE) return false;
+    if (port_queued[pn] < PORT_SHARE(pn)) return true;
+    uint8_t owed = 0;
+    LOOP_L_N(p, NUM_SERIAL)
+      if (p != pn && port_queued[p] < PORT_SHARE(p) && (serial_count[p] || serial_bytes_waiting(p)))
+        owed += PORT_SHARE(p) - port_queued[p];
+    return BUFSIZE - length > owed;
+  }
+
+  // Is there input on a port that may queue commands?
+  bool GCodeQueue::intake_ready() {
+    LOOP_L_N(p, NUM_SERIAL) if (serial_bytes_waiting(p) && port_may_queue(p)) return true;
+    return false;
+  }
+
+#endif
+
+#if BOTH(SERIAL_FAIR_INTAKE, EMERGENCY_PARSER)
+
+  // A line the emergency parser acted on: [N<num>] M108, M112 or M410
+  inline bool is_realtime(const char *cmd) {
+    if (!emergency_parser.is_enabled()) return false;   // Not while M28 writes lines to a file
+    if (*cmd == 'N') do cmd++; while (NUMERIC(*cmd) || *cmd == '-' || *cmd == ' ');
+    if (*cmd++ != 'M') return false;
+    while (*cmd == ' ') cmd++;
+    const char a = cmd[0], b = cmd[1], c = cmd[2], d = cmd[3];
+    if (d && d != ' ' && d != '*') return false;        // The whole code, not M1080 or M4100
+    return (a == '1' && ((b == '0' && c == '8') || (b == '1' && c == '2'))) || (a == '4' && b == '1' && c == '0');
+  }
+
+  // Acknowledge a real-time command without queueing it
+  void GCodeQueue::ok_realtime(const uint8_t pn) {
+    #if ENABLED(WINDOWED_OK)
+      if (windowed_ok[pn]) { credit_lines[pn]++; return; }
+    #endif
+    PORT_REDIRECT(pn);
+    SERIAL_ECHOPGM(STR_OK);
+    #if ENABLED(ADVANCED_OK)
+      SERIAL_ECHOPAIR_P(SP_P_STR, int(planner.moves_free()),
+                        SP_B_STR, int(BUFSIZE - length));
+    #endif
+    SERIAL_EOL();
+  }
+
+#endif
+
 void GCodeQueue::gcode_line_error(PGM_P const err, const int8_t pn) {
   PORT_REDIRECT(pn);                      // Reply to the serial port that sent the command
   SERIAL_ERROR_START();
@@ -346,7 +589,7 @@ FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", b
 #define PS_PAREN  3
 #define PS_ESC    4
 
-inline void process_stream_char(const char c, uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind) {
+inline void process_stream_char(const char c, uint8_t &sis, char * const buff, int &ind) {
 
   if (sis == PS_EOL) return;    // EOL comment or overflow
 
@@ -398,11 +641,64 @@ inline void process_stream_char(const char c, uint8_t &sis, char (&buff)[MAX_CMD
   }
 }
 
+/**
+ * The line number, checksum and M110 of a serial line, worked out as
+ * each character is stored so a finished line needs no more scanning.
+ */
+struct LineCheck {
+  bool numbered,      // The line starts with N
+       star,          // The line has a '*'
+       n2,            // An 'N' was seen 4 or more characters in
+       neg;           // The number being read is negative
+  uint8_t lead,       // Before the number: 2 = blanks or sign allowed, 1 = after sign, 0 = in digits
+          pos,        // Characters since the first non-blank (to 255)
+          sum,        // XOR of those characters
+          star_sum,   // XOR up to the last '*'
+          m110;       // Characters of "M110" matched (4 = found)
+  long line_N,        // The leading N number
+       n2_N,          // The number after that later 'N'
+       star_val,      // The number after the last '*'
+       *digits;       // The number being read, if any
+
+  void reset() {
+    numbered = star = n2 = neg = false;
+    lead = pos = sum = star_sum = m110 = 0;
+    line_N = n2_N = star_val = 0;
+    digits = nullptr;
+  }
+
+  void add(const char c) {
+    if (!pos && c == ' ') return;                 // Leading blanks aren't checksummed
+    // Read numbers the way strtol() does
+    if (digits) {
+      if (NUMERIC(c)) { *digits = *digits * 10 + (neg ? '0' - c : c - '0'); lead = 0; }
+      else if (lead == 2 && c == ' ') {}
+      else if (lead == 2 && (c == '-' || c == '+')) { neg = c == '-'; lead = 1; }
+      else digits = nullptr;
+    }
+    if (c == '*') { star = true; star_sum = sum; star_val = 0; digits = &star_val; }
+    else if (c == 'N') {
+      if (!pos) { numbered = true; digits = &line_N; }
+      else if (pos >= 4 && !n2) { n2 = true; digits = &n2_N; }
+    }
+    if (digits && (c == '*' || c == 'N')) { neg = false; lead = 2; }
+    if (m110 < 4) m110 = c == "M110"[m110] ? m110 + 1 : c == 'M';
+    sum ^= c;
+    if (pos < 255) pos++;
+  }
+
+  // After a backspace, start over from what's left
+  void rescan(const char * const buff, const int len) {
+    reset();
+    LOOP_L_N(i, len) add(buff[i]);
+  }
+};
+
 /**
  * Handle a line being completed. For an empty line
  * keep sensor readings going and watchdog alive.
  */
-inline bool process_line_done(uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind) {
+inline bool process_line_done(uint8_t &sis, char * const buff, int &ind) {
   sis = PS_NORMAL;
   buff[ind] = 0;
   if (ind) { ind = 0; return false; }
@@ -410,24 +706,54 @@ inline bool process_line_done(uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind
   return true;
 }
 
+#if ENABLED(SD_GCODE_CACHE)
+
+  bool GCodeQueue::sd_line_char(const char c, uint8_t &sis, char * const buff, int &ind) {
+    if (ISEOL(c)) { sis = PS_NORMAL; buff[ind] = 0; return true; }
+    process_stream_char(c, sis, buff, ind);
+    return false;
+  }
+
+#endif
+
 /**
  * Get all commands waiting on the serial port and queue them.
  * Exit when the buffer is full or when no more characters are
  * left on the serial port.
  */
 void GCodeQueue::get_serial_commands() {
-  static char serial_line_buffer[NUM_SERIAL][MAX_CMD_SIZE];
+  #if ENABLED(COMMAND_RING_BUFFER)
+    // The first port receives straight into the ring, the others into a line buffer
+    #if HAS_MULTI_SERIAL
+      static char serial_line_buffer[NUM_SERIAL - 1][MAX_CMD_SIZE];
+      #define SERIAL_LINE(I) ((I) ? serial_line_buffer[(I) - 1] : &ring[ring_w + 1])
+    #else
+      #define SERIAL_LINE(I) (&ring[ring_w + 1])
+    #endif
+  #else
+    static char serial_line_buffer[NUM_SERIAL][MAX_CMD_SIZE];
+    #define SERIAL_LINE(I) serial_line_buffer[I]
+  #endif
 
   static uint8_t serial_input_state[NUM_SERIAL] = { PS_NORMAL };
+  static LineCheck line_check[NUM_SERIAL];
 
   #if ENABLED(BINARY_FILE_TRANSFER)
     if (card.flag.binary_mode) {
+      // Queue the moves of the last MOTION packet before reading more
+      if (TERN0(BINARY_MOTION_PROTOCOL, !BinaryMotionProtocol::drain())) return;
+
       /**
        * For binary stream file transfer, use serial_line_buffer as the working
        * receive buffer (which limits the packet size to MAX_CMD_SIZE).
        * The receive buffer also limits the packet size for reliable transmission.
        */
-      binaryStream[card.transfer_port_index].receive(serial_line_buffer[card.transfer_port_index]);
+      #if ENABLED(COMMAND_RING_BUFFER)
+        if (card.transfer_port_index == 0 && !make_room(MAX_CMD_SIZE + 1)) return;
+        binaryStream[card.transfer_port_index].receive(*reinterpret_cast<char(*)[MAX_CMD_SIZE]>(SERIAL_LINE(card.transfer_port_index)));
+      #else
+        binaryStream[card.transfer_port_index].receive(serial_line_buffer[card.transfer_port_index]);
+      #endif
       return;
     }
   #endif
@@ -443,52 +769,64 @@ void GCodeQueue::get_serial_commands() {
     }
   #endif
 
+  #if ENABLED(WINDOWED_OK)
+    // Return credits in batches, or all at once when the queue runs dry
+    LOOP_L_N(p, NUM_SERIAL)
+      if (windowed_ok[p] && (credit_lines[p] >= WINDOWED_OK_BATCH || credit_bytes[p] >= (RX_WINDOW) / 2
+          || ((credit_lines[p] || credit_bytes[p]) && !length && !serial_bytes_waiting(p))))
+        send_credits(p);
+  #endif
+
   /**
    * Loop while serial characters are incoming and the queue is not full
    */
-  while (length < BUFSIZE && serial_data_available()) {
+  while (length < BUFSIZE && TERN(SERIAL_FAIR_INTAKE, intake_ready(), serial_data_available())) {
     LOOP_L_N(i, NUM_SERIAL) {
 
+      TERN_(SERIAL_FAIR_INTAKE, if (!port_may_queue(i)) continue);
+
+      #if ENABLED(COMMAND_RING_BUFFER)
+        // Keep room for a whole line at ring_w before starting one
+        if (i == 0 && !serial_count[0] && !make_room(MAX_CMD_SIZE + 1)) return;
+      #endif
+
       const int c = read_serial(i);
       if (c < 0) continue;
 
+      TERN_(WINDOWED_OK, if (windowed_ok[i]) credit_bytes[i]++);
+
       const char serial_char = c;
 
       if (ISEOL(serial_char)) {
 
+        #if ENABLED(COMMAND_RING_BUFFER)
+          const uint8_t len = serial_count[i];
+        #endif
+
         // Reset our state, continue if the line was empty
-        if (process_line_done(serial_input_state[i], serial_line_buffer[i], serial_count[i]))
+        if (process_line_done(serial_input_state[i], SERIAL_LINE(i), serial_count[i]))
           continue;
 
-        char* command = serial_line_buffer[i];
+        char* command = SERIAL_LINE(i);
 
         while (*command == ' ') command++;                   // Skip leading spaces
-        char *npos = (*command == 'N') ? command : nullptr;  // Require the N parameter to start the line
 
-        if (npos) {
+        const LineCheck &lc = line_check[i];
+        if (lc.numbered) {                                   // Require the N parameter to start the line
 
-          bool M110 = strstr_P(command, PSTR("M110")) != nullptr;
-
-          if (M110) {
-            char* n2pos = strchr(command + 4, 'N');
-            if (n2pos) npos = n2pos;
-          }
-
-          const long gcode_N = strtol(npos + 1, nullptr, 10);
+          // M110 takes its new line number from the next N
+          const bool M110 = lc.m110 == 4;
+          const long gcode_N = M110 && lc.n2 ? lc.n2_N : lc.line_N;
 
           if (gcode_N != last_N[i] + 1 && !M110)
             return gcode_line_error(PSTR(STR_ERR_LINE_NO), i);
 
-          char *apos = strrchr(command, '*');
-          if (apos) {
-            uint8_t checksum = 0, count = uint8_t(apos - command);
-            while (count) checksum ^= command[--count];
-            if (strtol(apos + 1, nullptr, 10) != checksum)
-              return gcode_line_error(PSTR(STR_ERR_CHECKSUM_MISMATCH), i);
-          }
-          else
+          if (!lc.star)
             return gcode_line_error(PSTR(STR_ERR_NO_CHECKSUM), i);
 
+          if (lc.star_val != lc.star_sum)
+            return gcode_line_error(PSTR(STR_ERR_CHECKSUM_MISMATCH), i);
+
           last_N[i] = gcode_N;
         }
         #if ENABLED(SDSUPPORT)
@@ -528,6 +866,9 @@ void GCodeQueue::get_serial_commands() {
           }
           if (strcmp_P(command, PSTR("M112")) == 0) kill(M112_KILL_STR, nullptr, true);
           if (strcmp_P(command, PSTR("M410")) == 0) quickstop_stepper();
+        #elif ENABLED(SERIAL_FAIR_INTAKE)
+          // Priority lane: Already handled, so answer now and skip the queue
+          if (is_realtime(command)) { ok_realtime(i); continue; }
         #endif
 
         #if defined(NO_TIMEOUTS) && NO_TIMEOUTS > 0
@@ -535,14 +876,33 @@ void GCodeQueue::get_serial_commands() {
         #endif
 
         // Add the command to the queue
-        _enqueue(serial_line_buffer[i], true
+        #if ENABLED(COMMAND_RING_BUFFER)
+          if (i == 0) {
+            commit_line(len, 0);          // Already in place
+            _commit_command(true
+              #if HAS_MULTI_SERIAL
+                , i
+              #endif
+            );
+            continue;
+          }
+        #endif
+        _enqueue(SERIAL_LINE(i), true
           #if HAS_MULTI_SERIAL
             , i
           #endif
         );
       }
-      else
-        process_stream_char(serial_char, serial_input_state[i], serial_line_buffer[i], serial_count[i]);
+      else {
+        const int was = serial_count[i];
+        process_stream_char(serial_char, serial_input_state[i], SERIAL_LINE(i), serial_count[i]);
+        if (serial_count[i] > was) {                         // Stored
+          if (!was) line_check[i].reset();
+          line_check[i].add(serial_char);
+        }
+        else if (serial_count[i] < was)                      // Backspace
+          line_check[i].rescan(SERIAL_LINE(i), serial_count[i]);
+      }
 
     } // for NUM_SERIAL
   } // queue has space, serial has data
@@ -561,9 +921,40 @@ void GCodeQueue::get_serial_commands() {
 
     if (!IS_SD_PRINTING()) return;
 
+    #if ENABLED(COMMAND_RING_BUFFER)
+      char *line = nullptr;
+      #define SD_LINE line
+    #else
+      #define SD_LINE command_buffer[index_w]
+    #endif
+
+    #if ENABLED(SD_GCODE_CACHE)
+      // Take pre-parsed lines from the cache. On failure go on with the text.
+      while (length < BUFSIZE && gcode_cache.active()) {
+        #if ENABLED(COMMAND_RING_BUFFER)
+          if (!(line = new_line(MAX_CMD_SIZE - 1))) return;
+        #endif
+        const uint8_t len = gcode_cache.next(SD_LINE), w = index_w;
+        if (!len) {
+          if (card.eof()) { card.fileHasFinished(); return; }
+          break;
+        }
+        const bool is_token = gcode_cache.is_token(SD_LINE);
+        TERN_(COMMAND_RING_BUFFER, commit_line(len, open_bytes()));
+        _commit_command(false);
+        token[w] = is_token;
+        #if ENABLED(POWER_LOSS_RECOVERY)
+          recovery.cmd_sdpos = card.getIndex();       // Prime for the NEXT _commit_command
+        #endif
+      }
+    #endif
+
     int sd_count = 0;
     bool card_eof = card.eof();
     while (length < BUFSIZE && !card_eof) {
+      #if ENABLED(COMMAND_RING_BUFFER)
+        if (!sd_count && !(line = new_line(MAX_CMD_SIZE - 1))) break;
+      #endif
       const int16_t n = card.get();
       card_eof = card.eof();
       if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
@@ -574,7 +965,11 @@ void GCodeQueue::get_serial_commands() {
 
         // Reset stream state, terminate the buffer, and commit a non-empty command
         if (!is_eol && sd_count) ++sd_count;          // End of file with no newline
-        if (!process_line_done(sd_input_state, command_buffer[index_w], sd_count)) {
+        #if ENABLED(COMMAND_RING_BUFFER)
+          const uint8_t len = sd_count;
+        #endif
+        if (!process_line_done(sd_input_state, SD_LINE, sd_count)) {
+          TERN_(COMMAND_RING_BUFFER, commit_line(len, open_bytes()));
           _commit_command(false);
           #if ENABLED(POWER_LOSS_RECOVERY)
             recovery.cmd_sdpos = card.getIndex();     // Prime for the NEXT _commit_command
@@ -584,7 +979,7 @@ void GCodeQueue::get_serial_commands() {
         if (card_eof) card.fileHasFinished();         // Handle end of file reached
       }
       else
-        process_stream_char(sd_char, sd_input_state, command_buffer[index_w], sd_count);
+        process_stream_char(sd_char, sd_input_state, SD_LINE, sd_count);
 
     }
   }
@@ -618,7 +1013,7 @@ void GCodeQueue::advance() {
   #if ENABLED(SDSUPPORT)
 
     if (card.flag.saving) {
-      char* command = command_buffer[index_r];
+      char* command = current_command();
       if (is_M29(command)) {
         // M29 closes the file
         card.closefile();
@@ -655,6 +1050,15 @@ void GCodeQueue::advance() {
   #endif // SDSUPPORT
 
   // The queue may be reset by a command handler or by code invoked by idle() within a handler
+  #if ENABLED(COMMAND_RING_BUFFER)
+    if (length) {
+      ring_r += uint8_t(ring[ring_r]) + 2;
+      if (length > 1 && (ring_r >= COMMAND_RING_BYTES || uint8_t(ring[ring_r]) == RING_WRAP)) ring_r = 0;
+    }
+  #endif
+  #if ENABLED(SERIAL_FAIR_INTAKE)
+    if (length && port[index_r] >= 0) port_queued[port[index_r]]--;
+  #endif
   --length;
   if (++index_r >= BUFSIZE) index_r = 0;
 
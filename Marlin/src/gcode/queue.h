@@ -50,7 +50,21 @@ public:
   static uint8_t length,  // Count of commands in the queue
                  index_r; // Ring buffer read position
 
-  static char command_buffer[BUFSIZE][MAX_CMD_SIZE];
+  #if ENABLED(COMMAND_RING_BUFFER)
+    /**
+     * With COMMAND_RING_BUFFER the command strings are stored back to back
+     * in a byte ring, each as [length][text][nul]. BUFSIZE only limits the
+     * number of commands. A RING_WRAP length marks the unused end of the ring.
+     */
+    #define RING_WRAP 0xFF
+    static char ring[COMMAND_RING_BYTES];
+    static uint16_t ring_r,   // Ring position of the oldest command
+                    ring_w;   // Ring position of the next command
+    static inline char* current_command() { return &ring[ring_r + 1]; }
+  #else
+    static char command_buffer[BUFSIZE][MAX_CMD_SIZE];
+    static inline char* current_command() { return command_buffer[index_r]; }
+  #endif
 
   /**
    * The port that the command was received on
@@ -63,6 +77,22 @@ public:
     return TERN0(HAS_MULTI_SERIAL, port[index_r]);
   }
 
+  #if ENABLED(SD_GCODE_CACHE)
+    static bool token[BUFSIZE];   // The command is a GCodeCache token record
+    static inline bool command_is_token() { return token[index_r]; }
+
+    // Split SD file text into lines. Return true with a nul-terminated line at EOL.
+    static bool sd_line_char(const char c, uint8_t &sis, char * const buff, int &ind);
+  #endif
+
+  #if ENABLED(BINARY_MOTION_PROTOCOL)
+    static bool move[BUFSIZE];    // The command is a BinaryMotionProtocol move
+    static inline bool command_is_move() { return move[index_r]; }
+
+    // Queue a decoded binary move of 'len' bytes. Return false if there's no room.
+    static bool enqueue_move(const char * const rec, const uint8_t len);
+  #endif
+
   GCodeQueue();
 
   /**
@@ -147,12 +177,49 @@ public:
    */
   static void flush_and_request_resend();
 
+  #if ENABLED(WINDOWED_OK)
+    /**
+     * Windowed "ok" (M576 S1). Hosts get credits for free command slots and
+     * RX buffer bytes, in place of one "ok" per line:
+     *   ok C<lines> R<bytes>  Credits for lines done and bytes read since the last grant
+     *   ok W<lines> R<bytes>  The whole window. The host drops all credits it had.
+     *                         Sent by M576 S1 and after every "Resend:"
+     * A line costs one line credit and its length in bytes, including the newline.
+     * Don't send blank or comment-only lines in this mode.
+     */
+    static bool windowed_ok[NUM_SERIAL];
+    static void send_window(const uint8_t pn);
+  #endif
+
 private:
 
   static uint8_t index_w;  // Ring buffer write position
 
   static void get_serial_commands();
 
+  #if ENABLED(WINDOWED_OK)
+    static uint8_t credit_lines[NUM_SERIAL];
+    static uint16_t credit_bytes[NUM_SERIAL];
+    static void send_credits(const uint8_t pn);
+  #endif
+
+  #if ENABLED(SERIAL_FAIR_INTAKE)
+    static uint8_t port_queued[NUM_SERIAL];   // Commands in the queue from each port
+    static bool port_may_queue(const uint8_t pn);
+    static bool intake_ready();
+  #endif
+
+  #if BOTH(SERIAL_FAIR_INTAKE, EMERGENCY_PARSER)
+    static void ok_realtime(const uint8_t pn);
+  #endif
+
+  #if ENABLED(COMMAND_RING_BUFFER)
+    static uint16_t open_bytes();
+    static bool make_room(const uint16_t bytes);
+    static char* new_line(const uint8_t len);
+    static void commit_line(const uint8_t len, const uint16_t skip);
+  #endif
+
   #if ENABLED(SDSUPPORT)
     static void get_sdcard_commands();
   #endif
@@ -31,6 +31,8 @@
  * M27: Get SD Card status
  *      OR, with 'S<seconds>' set the SD status auto-report interval. (Requires AUTO_REPORT_SD_STATUS)
  *      OR, with 'C' get the current filename.
+ *
+ * With SD_READ_AHEAD also report the bytes read ahead and the reads that had to wait.
  */
 void GcodeSuite::M27() {
   if (parser.seen('C')) {
@@ -43,8 +45,10 @@ void GcodeSuite::M27() {
       card.set_auto_report_interval(parser.value_byte());
   #endif
 
-  else
+  else {
     card.report_status();
+    TERN_(SD_READ_AHEAD, if (card.isPrinting()) sd_read_ahead.report());
+  }
 }
 
 #endif // SDSUPPORT
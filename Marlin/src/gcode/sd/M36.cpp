@@ -0,0 +1,47 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(SD_GCODE_CACHE)
+
+#include "../gcode.h"
+#include "../../sd/cardreader.h"
+
+/**
+ * M36 <filename>: Pre-parse an SD Card file for faster printing
+ *
+ * Writes FILE.GCT next to FILE.GCO. M23 uses it while it matches the file.
+ * The file is compiled in the background, between commands, so M36 returns
+ * at once. The cache is reported when it's done.
+ *
+ * M36 with no filename reports the bytes compiled so far.
+ */
+void GcodeSuite::M36() {
+  if (!parser.string_arg || !*parser.string_arg)
+    gcode_cache.report_compile();
+  else if (card.isMounted())
+    gcode_cache.compile(parser.string_arg);
+}
+
+#endif // SD_GCODE_CACHE
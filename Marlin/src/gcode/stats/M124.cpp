@@ -19,22 +19,24 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  *
  */
-#pragma once
 
-#include <mutex>
-#include <list>
-#include <fstream>
-#include "Gpio.h"
+#include "../../inc/MarlinConfig.h"
 
-class IOLoggerCSV: public IOLogger {
-public:
-  IOLoggerCSV(std::string filename);
-  virtual ~IOLoggerCSV();
-  void flush();
-  void log(GpioEvent ev);
+#if ENABLED(ISR_PROFILER)
 
-private:
-  std::ofstream file;
-  std::list<GpioEvent> events;
-  std::mutex vector_lock;
-};
+#include "../gcode.h"
+#include "../../feature/isr_profiler.h"
+
+/**
+ * M124: Report the CPU cycles spent in the Stepper and Temperature ISRs
+ *       since startup or the last reset: calls, min / avg / max cycles,
+ *       the estimate used for MAX_STEP_ISR_FREQUENCY, and a histogram.
+ *
+ *   R  Reset the counts after reporting
+ */
+void GcodeSuite::M124() {
+  isr_profiler.report();
+  if (parser.seen('R')) isr_profiler.reset();
+}
+
+#endif // ISR_PROFILER
@@ -0,0 +1,90 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(MPCTEMP)
+
+#include "../gcode.h"
+#include "../../lcd/ultralcd.h"
+#include "../../module/temperature.h"
+
+/**
+ * M306: MPC settings and autotune
+ *
+ *  E<extruder>  Extruder number. (Default: E0)
+ *  T             Autotune the model. Needs P and H set first.
+ *
+ *  P<float>      Heater power (W)
+ *  C<float>      Block heat capacity (J/K)
+ *  R<float>      Sensor responsiveness (K/s per ∆K)
+ *  A<float>      Heat transfer to the air with the fan off (W/K)
+ *  F<float>      Heat transfer to the air with the fan at full speed (W/K)
+ *  H<float>      Filament heat capacity per mm (J/K/mm)
+ *
+ * With no parameters, report the current values.
+ */
+void GcodeSuite::M306() {
+  const uint8_t e = parser.byteval('E');
+  if (e >= HOTENDS) {
+    SERIAL_ECHOLNPGM(STR_PID_BAD_EXTRUDER_NUM);
+    return;
+  }
+
+  if (parser.seen('T')) {
+    #if DISABLED(BUSY_WHILE_HEATING)
+      KEEPALIVE_STATE(NOT_BUSY);
+    #endif
+
+    ui.set_status(GET_TEXT(MSG_MPC_AUTOTUNE));
+    thermalManager.MPC_autotune(e);
+    ui.reset_status();
+    return;
+  }
+
+  if (parser.seen("PCRAFH")) {
+    MPC_t &constants = thermalManager.temp_hotend[e].constants;
+
+    // Values must be over 0. Leave the old value in place of a bad one.
+    auto set_value = [](const char code, float &value, const float max=0) {
+      if (!parser.seenval(code)) return;
+      const float v = parser.value_float();
+      if (v > 0 && (!max || v <= max))
+        value = v;
+      else if (max)
+        SERIAL_ECHO_MSG("!Invalid ", code, ". (0 < ", code, " <= ", max, ")");
+      else
+        SERIAL_ECHO_MSG("!Invalid ", code, ". (", code, " > 0)");
+    };
+    set_value('P', constants.heater_power);
+    set_value('C', constants.block_heat_capacity);
+    set_value('R', constants.sensor_responsiveness, MPC_MAX_SENSOR_RESPONSIVENESS);
+    set_value('A', constants.ambient_xfer_coeff_fan0);
+    set_value('F', constants.ambient_xfer_coeff_fan255);
+    set_value('H', constants.filament_heat_capacity_permm);
+    thermalManager.updateMPC(e);
+  }
+
+  thermalManager.log_mpc(e);
+}
+
+#endif // MPCTEMP
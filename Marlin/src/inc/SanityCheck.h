@@ -575,6 +575,14 @@
   #error "SERIAL_XON_XOFF and SERIAL_STATS_* features not supported on USB-native AVR devices."
 #endif
 
+#if ENABLED(SERIAL_DMA)
+  #if !(defined(__PLAT_LINUX__) || (defined(ARDUINO_ARCH_STM32) && !defined(STM32GENERIC)))
+    #error "SERIAL_DMA is only supported on STM32 (stm32duino) and LINUX."
+  #elif RX_BUFFER_SIZE < 2
+    #error "SERIAL_DMA requires RX_BUFFER_SIZE of 2 or more."
+  #endif
+#endif
+
 #if SERIAL_PORT > 7
   #error "Set SERIAL_PORT to the port on your board. Usually this is 0."
 #endif
@@ -1126,6 +1134,21 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #error "To use BED_LIMIT_SWITCHING you must disable PIDTEMPBED."
 #endif
 
+/**
+ * Hotend Heating Options - PID vs MPC
+ */
+#if ENABLED(MPCTEMP)
+  #if ENABLED(PIDTEMP)
+    #error "To use MPCTEMP you must disable PIDTEMP."
+  #elif !HAS_HOTEND
+    #error "MPCTEMP requires at least one hotend."
+  #endif
+#endif
+
+#if ENABLED(EXTRUSION_FEEDFORWARD) && NONE(MPCTEMP, PID_EXTRUSION_SCALING)
+  #error "EXTRUSION_FEEDFORWARD requires MPCTEMP or PID_EXTRUSION_SCALING."
+#endif
+
 /**
  * Kinematics
  */
@@ -1648,6 +1671,14 @@ static_assert(hbm[Z_AXIS] >= 0, "HOMING_BUMP_MM.Z must be greater than or equal
   #error "TEMP_SENSOR_CHAMBER 1000 requires CHAMBER_PULLUP_RESISTOR_OHMS, CHAMBER_RESISTANCE_25C_OHMS and CHAMBER_BETA in Configuration_adv.h."
 #endif
 
+#if ENABLED(FAST_USER_THERMISTORS)
+  #if !HAS_USER_THERMISTORS
+    #error "FAST_USER_THERMISTORS requires a TEMP_SENSOR set to 1000."
+  #elif !WITHIN(USER_THERMISTOR_TABLE_SIZE, 32, 255)
+    #error "USER_THERMISTOR_TABLE_SIZE must be from 32 to 255."
+  #endif
+#endif
+
 /**
  * A Sensor ID has to be set for each heater
  */
@@ -2057,6 +2088,68 @@ static_assert(hbm[Z_AXIS] >= 0, "HOMING_BUMP_MM.Z must be greater than or equal
   #error "EMERGENCY_PARSER does not work on boards with AT90USB processors (USBCON)."
 #endif
 
+/**
+ * Command queue
+ */
+#if ENABLED(COMMAND_RING_BUFFER)
+  #if BUFSIZE > 255
+    #error "BUFSIZE must be 255 or less with COMMAND_RING_BUFFER."
+  #elif MAX_CMD_SIZE > 255
+    #error "MAX_CMD_SIZE must be 255 or less with COMMAND_RING_BUFFER."
+  #elif COMMAND_RING_BYTES < 4 * (MAX_CMD_SIZE) || COMMAND_RING_BYTES > 65535
+    #error "COMMAND_RING_BYTES must be from 4 * MAX_CMD_SIZE to 65535."
+  #endif
+#endif
+
+#if ENABLED(WINDOWED_OK)
+  #if !WITHIN(WINDOWED_OK_BATCH, 1, (BUFSIZE) - 1)
+    #error "WINDOWED_OK_BATCH must be from 1 to BUFSIZE - 1."
+  #elif BUFSIZE > 255
+    #error "BUFSIZE must be 255 or less with WINDOWED_OK."
+  #endif
+#endif
+
+#if ENABLED(SERIAL_FAIR_INTAKE)
+  #ifndef SERIAL_PORT_2
+    #error "SERIAL_FAIR_INTAKE requires SERIAL_PORT_2."
+  #elif !defined(SERIAL_PORT_WEIGHTS)
+    #error "SERIAL_FAIR_INTAKE requires SERIAL_PORT_WEIGHTS."
+  #elif BUFSIZE < 2
+    #error "SERIAL_FAIR_INTAKE requires BUFSIZE of 2 or more."
+  #endif
+#endif
+
+/**
+ * G-code parser
+ */
+#if ENABLED(FASTER_GCODE_VALUES) && DISABLED(FASTER_GCODE_PARSER)
+  #error "FASTER_GCODE_VALUES requires FASTER_GCODE_PARSER."
+#endif
+
+#if ENABLED(BINARY_MOTION_PROTOCOL) && DISABLED(FASTER_GCODE_VALUES)
+  #error "BINARY_MOTION_PROTOCOL requires FASTER_GCODE_VALUES."
+#endif
+
+#if ENABLED(SD_GCODE_CACHE)
+  #if DISABLED(SDSUPPORT)
+    #error "SD_GCODE_CACHE requires SDSUPPORT."
+  #elif DISABLED(FASTER_GCODE_VALUES)
+    #error "SD_GCODE_CACHE requires FASTER_GCODE_VALUES."
+  #elif ENABLED(SDCARD_READONLY)
+    #error "SD_GCODE_CACHE is incompatible with SDCARD_READONLY."
+  #endif
+#endif
+
+#if ENABLED(SD_READ_AHEAD)
+  #if DISABLED(SDSUPPORT)
+    #error "SD_READ_AHEAD requires SDSUPPORT."
+  #elif !WITHIN(SD_READ_AHEAD_BUFFERS, 2, 4)
+    #error "SD_READ_AHEAD_BUFFERS must be from 2 to 4."
+  #elif !WITHIN(SD_READ_AHEAD_BLOCKS, 1, 8)
+    #error "SD_READ_AHEAD_BLOCKS must be from 1 to 8."
+  #endif
+#endif
+
 /**
  * I2C bus
  */
@@ -2640,6 +2733,13 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
 #if !BLOCK_BUFFER_SIZE || !IS_POWER_OF_2(BLOCK_BUFFER_SIZE)
   #error "BLOCK_BUFFER_SIZE must be a power of 2."
 #endif
+#if ENABLED(ADAPTIVE_BLOCK_BUFFER)
+  #if !IS_POWER_OF_2(BLOCK_BUFFER_SIZE_MAX) || BLOCK_BUFFER_SIZE_MAX > 128
+    #error "BLOCK_BUFFER_SIZE_MAX must be a power of 2, up to 128."
+  #elif BLOCK_BUFFER_SIZE_MAX < BLOCK_BUFFER_SIZE
+    #error "BLOCK_BUFFER_SIZE_MAX must be at least BLOCK_BUFFER_SIZE."
+  #endif
+#endif
 
 #if ENABLED(LED_CONTROL_MENU) && DISABLED(ULTIPANEL)
   #error "LED_CONTROL_MENU requires an LCD controller."
@@ -3017,6 +3117,44 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
   #error "SAVED_POSITIONS must be an integer from 0 to 256."
 #endif
 
+/**
+ * Planner Benchmark runs on the native Linux build only
+ */
+#if ENABLED(PLANNER_BENCHMARK) && !defined(__PLAT_LINUX__)
+  #error "PLANNER_BENCHMARK requires the native Linux build (HAL/LINUX)."
+#endif
+
+/**
+ * Vector junction math replaces the Junction Deviation math
+ */
+#if ENABLED(VECTOR_JUNCTION_DEVIATION) && !HAS_JUNCTION_DEVIATION
+  #error "VECTOR_JUNCTION_DEVIATION requires Junction Deviation. Disable CLASSIC_JERK."
+#endif
+
+/**
+ * Virtual time replaces the Linux timers
+ */
+#if ENABLED(LINUX_VIRTUAL_TIME)
+  #ifndef __PLAT_LINUX__
+    #error "LINUX_VIRTUAL_TIME requires the native Linux build (HAL/LINUX)."
+  #elif ENABLED(PLANNER_BENCHMARK)
+    #error "LINUX_VIRTUAL_TIME and PLANNER_BENCHMARK cannot be used together."
+  #endif
+#endif
+
+/**
+ * Batched step pulses need port writes from the HAL and plain step pins
+ */
+#if ENABLED(BATCHED_STEP_PULSES)
+  #ifndef WRITE_PORT_SET
+    #error "BATCHED_STEP_PULSES is not supported by this HAL. Only LPC176x and Linux can write a GPIO port."
+  #elif ENABLED(SQUARE_WAVE_STEPPING)
+    #error "BATCHED_STEP_PULSES is not compatible with SQUARE_WAVE_STEPPING."
+  #elif ENABLED(I2S_STEPPER_STREAM)
+    #error "BATCHED_STEP_PULSES is not compatible with I2S_STEPPER_STREAM."
+  #endif
+#endif
+
 /**
  * Sanity checks for stepper chunk support
  */
@@ -3025,3 +3163,31 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
     #error "DIRECT_STEPPING is incompatible with LIN_ADVANCE. Enable in external planner if possible."
   #endif
 #endif
+
+/**
+ * ISR profiler needs a cycle counter
+ */
+#if ENABLED(ISR_PROFILER)
+  #if defined(__arm__) || defined(__thumb__)
+    #if defined(__ARM_ARCH_6M__) || (defined(__CORTEX_M) && __CORTEX_M < 3)
+      #error "ISR_PROFILER requires an ARM Cortex-M3 or better (with a DWT cycle counter)."
+    #endif
+  #elif !defined(__AVR__) && !defined(__PLAT_LINUX__)
+    #error "ISR_PROFILER is only available for AVR, ARM Cortex-M3/M4/M7 and Linux."
+  #endif
+#endif
+
+/**
+ * Step segment queue
+ */
+#if ENABLED(STEP_SEGMENT_QUEUE)
+  #if !STEP_SEGMENT_QUEUE_SIZE || !IS_POWER_OF_2(STEP_SEGMENT_QUEUE_SIZE) || STEP_SEGMENT_QUEUE_SIZE > 256
+    #error "STEP_SEGMENT_QUEUE_SIZE must be a power of 2, up to 256."
+  #elif !WITHIN(STEP_SEGMENTS_PER_SECOND, 100, 10000)
+    #error "STEP_SEGMENTS_PER_SECOND must be between 100 and 10000."
+  #elif ENABLED(DIRECT_STEPPING)
+    #error "STEP_SEGMENT_QUEUE is incompatible with DIRECT_STEPPING."
+  #elif ENABLED(LASER_POWER_INLINE_TRAPEZOID)
+    #error "STEP_SEGMENT_QUEUE is incompatible with LASER_POWER_INLINE_TRAPEZOID."
+  #endif
+#endif
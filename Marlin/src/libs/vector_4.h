@@ -0,0 +1,93 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * vector_4.h - Packed XYZE vector for the junction deviation math
+ *
+ * The four lanes live in one GCC vector type. On the Linux host each
+ * operation is a single SSE instruction. Targets without float SIMD
+ * (AVR, and Cortex-M4F/M7, whose DSP instructions are integer only) get
+ * the lanes unrolled into straight-line FPU or soft-float code.
+ */
+
+#include "../core/types.h"
+
+#ifdef __SSE__
+  #include <xmmintrin.h>
+#endif
+
+typedef float v4sf_t __attribute__((vector_size(16)));
+typedef int32_t v4si_t __attribute__((vector_size(16)));
+
+struct vector_4 {
+  v4sf_t v;
+
+  FORCE_INLINE vector_4(const v4sf_t &in) : v(in) {}
+  FORCE_INLINE vector_4(const xyze_float_t &in) : v{ in.x, in.y, in.z, in.e } {}
+  FORCE_INLINE vector_4(const float &a, const float &b, const float &c, const float &d) : v{ a, b, c, d } {}
+
+  FORCE_INLINE void store(xyze_float_t &out) const { out.set(v[0], v[1], v[2], v[3]); }
+
+  FORCE_INLINE vector_4 operator-(const vector_4 &rs) const { return v - rs.v; }
+  FORCE_INLINE vector_4 operator*(const vector_4 &rs) const { return v * rs.v; }
+  FORCE_INLINE vector_4 operator/(const vector_4 &rs) const { return v / rs.v; }
+  FORCE_INLINE vector_4 operator*(const float &s)     const { return v * (v4sf_t){ s, s, s, s }; }
+
+  FORCE_INLINE float sum() const { return (v[0] + v[1]) + (v[2] + v[3]); }
+  FORCE_INLINE float dot(const vector_4 &rs) const { return vector_4(v * rs.v).sum(); }
+
+  // Clear the sign bits
+  FORCE_INLINE vector_4 absolute() const { return (v4sf_t)((v4si_t)v & 0x7FFFFFFF); }
+
+  // Smallest of m and the lanes, ignoring NaN lanes
+  FORCE_INLINE float min_lane(float m) const {
+    if (v[0] < m) m = v[0];
+    if (v[1] < m) m = v[1];
+    if (v[2] < m) m = v[2];
+    if (v[3] < m) m = v[3];
+    return m;
+  }
+};
+
+/**
+ * 1 / sqrt(x), for x > 0. With SSE, the rsqrt estimate refined by one
+ * Newton-Raphson step (about 22 bits). Otherwise RSQRT, as in the scalar
+ * code, which is VSQRT and VDIV on an FPU.
+ */
+FORCE_INLINE float fast_rsqrt(const float x) {
+  #ifdef __SSE__
+    const float r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return r * (1.5f - 0.5f * x * r * r);
+  #else
+    return RSQRT(x);
+  #endif
+}
+
+// sqrt(x), for x > 0. With SSE, x * fast_rsqrt(x) avoids the SQRTSS latency.
+FORCE_INLINE float fast_sqrt(const float x) {
+  #ifdef __SSE__
+    return x * fast_rsqrt(x);
+  #else
+    return SQRT(x);
+  #endif
+}
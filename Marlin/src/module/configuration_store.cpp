@@ -155,6 +155,30 @@ static const uint32_t   _DMA[] PROGMEM = DEFAULT_MAX_ACCELERATION;
 static const float     _DASU[] PROGMEM = DEFAULT_AXIS_STEPS_PER_UNIT;
 static const feedRate_t _DMF[] PROGMEM = DEFAULT_MAX_FEEDRATE;
 
+#if ENABLED(MPCTEMP)
+  static void reset_mpc(const uint8_t e) {
+    constexpr float heater_power[] = MPC_HEATER_POWER,
+                    block_heat_capacity[] = MPC_BLOCK_HEAT_CAPACITY,
+                    sensor_responsiveness[] = MPC_SENSOR_RESPONSIVENESS,
+                    ambient_xfer_coeff_fan0[] = MPC_AMBIENT_XFER_COEFF,
+                    ambient_xfer_coeff_fan255[] = MPC_AMBIENT_XFER_COEFF_FAN255,
+                    filament_heat_capacity_permm[] = MPC_FILAMENT_HEAT_CAPACITY_PERMM;
+    static_assert(WITHIN(COUNT(heater_power), 1, HOTENDS), "MPC_HEATER_POWER must have between 1 and HOTENDS items.");
+    static_assert(WITHIN(COUNT(block_heat_capacity), 1, HOTENDS), "MPC_BLOCK_HEAT_CAPACITY must have between 1 and HOTENDS items.");
+    static_assert(WITHIN(COUNT(sensor_responsiveness), 1, HOTENDS), "MPC_SENSOR_RESPONSIVENESS must have between 1 and HOTENDS items.");
+    static_assert(WITHIN(COUNT(ambient_xfer_coeff_fan0), 1, HOTENDS), "MPC_AMBIENT_XFER_COEFF must have between 1 and HOTENDS items.");
+    static_assert(WITHIN(COUNT(ambient_xfer_coeff_fan255), 1, HOTENDS), "MPC_AMBIENT_XFER_COEFF_FAN255 must have between 1 and HOTENDS items.");
+    static_assert(WITHIN(COUNT(filament_heat_capacity_permm), 1, HOTENDS), "MPC_FILAMENT_HEAT_CAPACITY_PERMM must have between 1 and HOTENDS items.");
+    MPC_t &constants = thermalManager.temp_hotend[e].constants;
+    constants.heater_power = heater_power[ALIM(e, heater_power)];
+    constants.block_heat_capacity = block_heat_capacity[ALIM(e, block_heat_capacity)];
+    constants.sensor_responsiveness = sensor_responsiveness[ALIM(e, sensor_responsiveness)];
+    constants.ambient_xfer_coeff_fan0 = ambient_xfer_coeff_fan0[ALIM(e, ambient_xfer_coeff_fan0)];
+    constants.ambient_xfer_coeff_fan255 = ambient_xfer_coeff_fan255[ALIM(e, ambient_xfer_coeff_fan255)];
+    constants.filament_heat_capacity_permm = filament_heat_capacity_permm[ALIM(e, filament_heat_capacity_permm)];
+  }
+#endif
+
 extern const char SP_X_STR[], SP_Y_STR[], SP_Z_STR[], SP_E_STR[];
 
 /**
@@ -299,6 +323,13 @@ typedef struct SettingsDataStruct {
   //
   PID_t bedPID;                                         // M304 PID / M303 E-1 U
 
+  //
+  // MPCTEMP
+  //
+  #if ENABLED(MPCTEMP)
+    MPC_t hotendMPC[HOTENDS];                           // M306 En PCRAFH / M306 En T
+  #endif
+
   //
   // User-defined Thermistors
   //
@@ -430,6 +461,11 @@ void MarlinSettings::postprocess() {
   TERN_(DELTA, recalc_delta_settings());
 
   TERN_(PIDTEMP, thermalManager.updatePID());
+  TERN_(MPCTEMP, HOTEND_LOOP() thermalManager.updateMPC(e));
+
+  #if HAS_USER_THERMISTORS
+    LOOP_L_N(i, USER_THERMISTORS) thermalManager.update_user_thermistor(i);
+  #endif
 
   #if DISABLED(NO_VOLUMETRICS)
     planner.calculate_volumetric_multipliers();
@@ -865,6 +901,16 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(bed_pid);
     }
 
+    //
+    // MPCTEMP
+    //
+    #if ENABLED(MPCTEMP)
+    {
+      _FIELD_TEST(hotendMPC);
+      HOTEND_LOOP() EEPROM_WRITE(thermalManager.temp_hotend[e].constants);
+    }
+    #endif
+
     //
     // User-defined Thermistors
     //
@@ -1728,6 +1774,27 @@ void MarlinSettings::postprocess() {
         #endif
       }
 
+      //
+      // Hotend MPC
+      //
+      #if ENABLED(MPCTEMP)
+      {
+        _FIELD_TEST(hotendMPC);
+        HOTEND_LOOP() {
+          MPC_t mpc;
+          EEPROM_READ(mpc);
+          if (!validating) {
+            if (thermalManager.MPC_valid(mpc))
+              thermalManager.temp_hotend[e].constants = mpc;
+            else {
+              SERIAL_ERROR_MSG("Invalid MPC constants for E", int(e), ". Using defaults.");
+              reset_mpc(e);
+            }
+          }
+        }
+      }
+      #endif
+
       //
       // User-defined Thermistors
       //
@@ -2658,6 +2725,12 @@ void MarlinSettings::reset() {
     thermalManager.temp_bed.pid.Kd = scalePID_d(DEFAULT_bedKd);
   #endif
 
+  //
+  // Hotend MPC
+  //
+
+  TERN_(MPCTEMP, HOTEND_LOOP() reset_mpc(e));
+
   //
   // User-Defined Thermistors
   //
@@ -2967,6 +3040,14 @@ void MarlinSettings::reset() {
       #endif
     );
 
+    #if ENABLED(ADAPTIVE_BLOCK_BUFFER)
+      if (!forReplay) {
+        config_heading(forReplay, PSTR("Planner buffer: "), false);
+        SERIAL_ECHO(int(planner.block_buffer_size));
+        SERIAL_ECHOLNPGM(" blocks");
+      }
+    #endif
+
     #if HAS_M206_COMMAND
       CONFIG_ECHO_HEADING("Home offset:");
       CONFIG_ECHO_START();
@@ -3219,6 +3300,14 @@ void MarlinSettings::reset() {
 
     #endif // PIDTEMP || PIDTEMPBED
 
+    #if ENABLED(MPCTEMP)
+      CONFIG_ECHO_HEADING("Model predictive control:");
+      HOTEND_LOOP() {
+        CONFIG_ECHO_START();
+        thermalManager.log_mpc(e, true);
+      }
+    #endif
+
     #if HAS_USER_THERMISTORS
       CONFIG_ECHO_HEADING("User thermistors:");
       LOOP_L_N(i, USER_THERMISTORS)
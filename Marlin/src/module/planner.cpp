@@ -111,6 +111,14 @@
   #include "../feature/spindle_laser.h"
 #endif
 
+#if ENABLED(PLANNER_BENCHMARK)
+  #include "../feature/planner_benchmark.h"
+#endif
+
+#if ENABLED(STEP_SEGMENT_QUEUE)
+  #include "../feature/step_segments.h"
+#endif
+
 // Delay for delivery of first block to the stepper ISR, if the queue contains 2 or
 // fewer movements. The delay is measured in milliseconds, and must be less than 250ms
 #define BLOCK_DELAY_FOR_1ST_MOVE 100
@@ -122,7 +130,13 @@ Planner planner;
 /**
  * A ring buffer of moves described in steps
  */
-block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
+#if ENABLED(ADAPTIVE_BLOCK_BUFFER)
+  block_t *Planner::block_buffer; // = nullptr
+  uint8_t Planner::block_buffer_size = BLOCK_BUFFER_SIZE,
+          Planner::block_buffer_mask = (BLOCK_BUFFER_SIZE) - 1;
+#else
+  block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
+#endif
 volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be pushed
                  Planner::block_buffer_nonbusy, // Index of the first non-busy block
                  Planner::block_buffer_planned, // Index of the optimally planned block
@@ -238,12 +252,49 @@ float Planner::previous_nominal_speed_sqr;
   volatile uint32_t Planner::block_buffer_runtime_us = 0;
 #endif
 
+#if ENABLED(INCREMENTAL_REPLANNING)
+  uint8_t Planner::block_buffer_stable;
+  #if ENABLED(PLANNER_BENCHMARK)
+    bool Planner::full_replan; // = false
+  #endif
+#endif
+
 /**
  * Class and Instance Methods
  */
 
 Planner::Planner() { init(); }
 
+#if ENABLED(ADAPTIVE_BLOCK_BUFFER)
+
+  /**
+   * Allocate the largest ring, up to BLOCK_BUFFER_SIZE_MAX blocks, that leaves
+   * BLOCK_BUFFER_RAM_RESERVE bytes free. The ring is the only block storage, so
+   * BLOCK_BUFFER_SIZE blocks are allocated even if that cuts into the reserve.
+   */
+  void Planner::allocate_block_buffer() {
+    const int32_t spare = int32_t(freeMemory()) - (BLOCK_BUFFER_RAM_RESERVE);
+    uint16_t size = BLOCK_BUFFER_SIZE_MAX;
+    while (size > (BLOCK_BUFFER_SIZE) && int32_t(size * sizeof(block_t)) > spare) size >>= 1;
+
+    for (; size >= (BLOCK_BUFFER_SIZE); size >>= 1) {
+      block_t * const buffer = (block_t*)calloc(size, sizeof(block_t));
+      if (buffer) {
+        block_buffer = buffer;
+        block_buffer_size = size;
+        block_buffer_mask = size - 1;
+        break;
+      }
+    }
+    if (!block_buffer) {
+      SERIAL_ERROR_MSG("No RAM for the planner buffer");
+      minkill();
+    }
+    clear_block_buffer();
+  }
+
+#endif
+
 void Planner::init() {
   position.reset();
   TERN_(HAS_POSITION_FLOAT, position_float.reset());
@@ -738,26 +789,43 @@ block_t* Planner::get_current_block() {
       //  to wait, do not deliver anything
       if (nr_moves < 3 && delay_before_delivering) return nullptr;
       delay_before_delivering = 0;
+      // Starting from rest, so give the segment compiler a chance at the first block
+      if (ENABLED(STEP_SEGMENT_QUEUE)) return nullptr;
     }
 
-    // If we are here, there is no excuse to deliver the block
-    block_t * const block = &block_buffer[block_buffer_tail];
+    #if ENABLED(STEP_SEGMENT_QUEUE)
 
-    // No trapezoid calculated? Don't execute yet.
-    if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return nullptr;
+      // Blocks frozen by the segment compiler come with their step timing.
+      // If the compiler fell behind, start the block anyway rather than stop
+      // from speed, and let the Stepper ISR work out its timing.
+      if (block_buffer_tail == block_buffer_nonbusy) {
+        if (TEST(block_buffer[block_buffer_tail].flag, BLOCK_BIT_RECALCULATE)) return nullptr;
+        freeze_nonbusy_block();
+      }
+      return &block_buffer[block_buffer_tail];
 
-    // We can't be sure how long an active block will take, so don't count it.
-    TERN_(HAS_SPI_LCD, block_buffer_runtime_us -= block->segment_time_us);
+    #else
 
-    // As this block is busy, advance the nonbusy block pointer
-    block_buffer_nonbusy = next_block_index(block_buffer_tail);
+      // If we are here, there is no excuse to deliver the block
+      block_t * const block = &block_buffer[block_buffer_tail];
 
-    // Push block_buffer_planned pointer, if encountered.
-    if (block_buffer_tail == block_buffer_planned)
-      block_buffer_planned = block_buffer_nonbusy;
+      // No trapezoid calculated? Don't execute yet.
+      if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return nullptr;
+
+      // We can't be sure how long an active block will take, so don't count it.
+      TERN_(HAS_SPI_LCD, block_buffer_runtime_us -= block->segment_time_us);
+
+      // As this block is busy, advance the nonbusy block pointer
+      block_buffer_nonbusy = next_block_index(block_buffer_tail);
+
+      // Push block_buffer_planned pointer, if encountered.
+      if (block_buffer_tail == block_buffer_planned)
+        block_buffer_planned = block_buffer_nonbusy;
+
+      // Return the block
+      return block;
 
-    // Return the block
-    return block;
+    #endif
   }
 
   // The queue became empty
@@ -766,6 +834,43 @@ block_t* Planner::get_current_block() {
   return nullptr;
 }
 
+#if ENABLED(STEP_SEGMENT_QUEUE)
+
+  /**
+   * Get the next block for the segment compiler, without freezing it.
+   * Return nullptr if there is none, it has no trapezoid yet,
+   * or there is a first-block delay.
+   *
+   * Only blocks before block_buffer_planned are handed out. A newer block
+   * can still speed up when more moves arrive, and the newest is planned
+   * to stop, so freezing it early would lose look-ahead. The Stepper ISR
+   * takes those blocks itself if it gets to them first.
+   */
+  block_t* Planner::peek_nonbusy_block() {
+    if (block_buffer_nonbusy == block_buffer_planned || delay_before_delivering) return nullptr;
+    block_t * const block = &block_buffer[block_buffer_nonbusy];
+    return TEST(block->flag, BLOCK_BIT_RECALCULATE) ? nullptr : block;
+  }
+
+  /**
+   * Mark the block returned by peek_nonbusy_block() as busy, so the
+   * planner stops changing it and the Stepper ISR can execute it.
+   */
+  void Planner::freeze_nonbusy_block() {
+    // We can't be sure how long an active block will take, so don't count it.
+    TERN_(HAS_SPI_LCD, block_buffer_runtime_us -= block_buffer[block_buffer_nonbusy].segment_time_us);
+
+    const uint8_t nonbusy = block_buffer_nonbusy;
+
+    // Push block_buffer_planned pointer, if encountered.
+    if (nonbusy == block_buffer_planned)
+      block_buffer_planned = next_block_index(nonbusy);
+
+    block_buffer_nonbusy = next_block_index(nonbusy);
+  }
+
+#endif // STEP_SEGMENT_QUEUE
+
 /**
  * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
  * by the provided factors.
@@ -777,6 +882,7 @@ block_t* Planner::get_current_block() {
  * alter its values.
  */
 void Planner::calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor) {
+  TERN_(PLANNER_BENCHMARK, BENCH_KERNEL(TRAPEZOID));
 
   uint32_t initial_rate = CEIL(block->nominal_rate * entry_factor),
            final_rate = CEIL(block->nominal_rate * exit_factor); // (steps per second)
@@ -944,6 +1050,7 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
 
 // The kernel called by recalculate() when scanning the plan from last to first entry.
 void Planner::reverse_pass_kernel(block_t* const current, const block_t * const next) {
+  TERN_(PLANNER_BENCHMARK, BENCH_KERNEL(REVERSE));
   if (current) {
     // If entry speed is already at the maximum entry speed, and there was no change of speed
     // in the next block, there is no need to recheck. Block is cruising and there is no need to
@@ -995,6 +1102,8 @@ void Planner::reverse_pass_kernel(block_t* const current, const block_t * const
  * Once in reverse and once forward. This implements the reverse pass.
  */
 void Planner::reverse_pass() {
+  TERN_(PLANNER_BENCHMARK, BENCH_SCOPE(REVERSE_PASS));
+
   // Initialize block index to the last block in the planner buffer.
   uint8_t block_index = prev_block_index(block_buffer_head);
 
@@ -1018,7 +1127,24 @@ void Planner::reverse_pass() {
 
     // Only consider non sync and page blocks
     if (!TEST(current->flag, BLOCK_BIT_SYNC_POSITION) && !IS_PAGE(current)) {
+      #if ENABLED(INCREMENTAL_REPLANNING)
+        const float old_entry_speed_sqr = current->entry_speed_sqr;
+      #endif
+
       reverse_pass_kernel(current, next);
+
+      #if ENABLED(INCREMENTAL_REPLANNING)
+        // The entry speed of an older block was planned either by an earlier reverse pass or
+        // lowered below that by the forward pass. So if this entry speed didn't change, the
+        // older blocks would get the same values again. Stop here and let the forward pass
+        // and trapezoid update start from this block. (The newest block has no previous
+        // entry speed to compare against, so it never stops the pass.)
+        if (next && current->entry_speed_sqr == old_entry_speed_sqr && !TERN0(PLANNER_BENCHMARK, full_replan)) {
+          block_buffer_stable = block_index;
+          return;
+        }
+      #endif
+
       next = current;
     }
 
@@ -1041,6 +1167,7 @@ void Planner::reverse_pass() {
 
 // The kernel called by recalculate() when scanning the plan from first to last entry.
 void Planner::forward_pass_kernel(const block_t* const previous, block_t* const current, const uint8_t block_index) {
+  TERN_(PLANNER_BENCHMARK, BENCH_KERNEL(FORWARD));
   if (previous) {
     // If the previous block is an acceleration block, too short to complete the full speed
     // change, adjust the entry speed accordingly. Entry speeds have already been reset,
@@ -1094,6 +1221,7 @@ void Planner::forward_pass_kernel(const block_t* const previous, block_t* const
  * Once in reverse and once forward. This implements the forward pass.
  */
 void Planner::forward_pass() {
+  TERN_(PLANNER_BENCHMARK, BENCH_SCOPE(FORWARD_PASS));
 
   // Forward Pass: Forward plan the acceleration curve from the planned pointer onward.
   // Also scans for optimal plan breakpoints and appropriately updates the planned pointer.
@@ -1104,6 +1232,14 @@ void Planner::forward_pass() {
   //  pass will never modify the values at the tail.
   uint8_t block_index = block_buffer_planned;
 
+  #if ENABLED(INCREMENTAL_REPLANNING)
+    // Blocks older than the stable block kept their entry speeds, so start there
+    // unless the Stepper ISR already pushed the planned pointer beyond it.
+    if (block_buffer_stable != block_buffer_head
+      && BLOCK_MOD(block_buffer_head - block_buffer_stable) < BLOCK_MOD(block_buffer_head - block_index)
+    ) block_index = block_buffer_stable;
+  #endif
+
   block_t *block;
   const block_t * previous = nullptr;
   while (block_index != block_buffer_head) {
@@ -1133,9 +1269,20 @@ void Planner::forward_pass() {
  * recalculate() after updating the blocks.
  */
 void Planner::recalculate_trapezoids() {
+  TERN_(PLANNER_BENCHMARK, BENCH_SCOPE(TRAPEZOIDS));
+
   // The tail may be changed by the ISR so get a local copy.
   uint8_t block_index = block_buffer_tail,
           head_block_index = block_buffer_head;
+
+  #if ENABLED(INCREMENTAL_REPLANNING)
+    // Only blocks newer than the stable block can be marked RECALCULATE,
+    // so skip the older ones unless the Stepper ISR already took it.
+    if (block_buffer_stable != head_block_index
+      && BLOCK_MOD(head_block_index - block_buffer_stable) < BLOCK_MOD(head_block_index - block_index)
+    ) block_index = block_buffer_stable;
+  #endif
+
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
   // specially handled), scan backwards to the first non-SYNC block.
@@ -1238,17 +1385,118 @@ void Planner::recalculate_trapezoids() {
   }
 }
 
+#if BOTH(INCREMENTAL_REPLANNING, PLANNER_BENCHMARK)
+
+  // Copies of the ring for the shadow check (block indexes are 8 bits)
+  static block_t ring_before[256], ring_incremental[256];
+
+  /**
+   * Run the replan that recalculate() just did again from the same blocks,
+   * with full passes as without INCREMENTAL_REPLANNING, and count the blocks
+   * whose entry speed, rates or step counts came out different. The
+   * benchmark runs the Stepper ISR inline, so nothing moves meanwhile.
+   * The incremental result is kept.
+   */
+  void Planner::check_full_replan(const uint8_t planned_before) {
+    const uint8_t planned_incremental = block_buffer_planned;
+    memcpy(ring_incremental, block_buffer, sizeof(block_t) * (BLOCK_BUFFER_DEPTH));
+    memcpy(block_buffer, ring_before, sizeof(block_t) * (BLOCK_BUFFER_DEPTH));
+    block_buffer_planned = planned_before;
+
+    PlannerBenchmark::shadowing = full_replan = true;
+    block_buffer_stable = block_buffer_head; // Skip no blocks
+    if (prev_block_index(block_buffer_head) != block_buffer_planned) {
+      reverse_pass();
+      forward_pass();
+    }
+    recalculate_trapezoids();
+    PlannerBenchmark::shadowing = full_replan = false;
+
+    for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b))
+      PlannerBenchmark::check_replan(ring_incremental[b], block_buffer[b]);
+
+    memcpy(block_buffer, ring_incremental, sizeof(block_t) * (BLOCK_BUFFER_DEPTH));
+    block_buffer_planned = planned_incremental;
+  }
+
+#endif
+
 void Planner::recalculate() {
-  // Initialize block index to the last block in the planner buffer.
-  const uint8_t block_index = prev_block_index(block_buffer_head);
-  // If there is just one block, no planning can be done. Avoid it!
-  if (block_index != block_buffer_planned) {
-    reverse_pass();
-    forward_pass();
+  #if BOTH(INCREMENTAL_REPLANNING, PLANNER_BENCHMARK)
+    const uint8_t planned_before = block_buffer_planned;
+    memcpy(ring_before, block_buffer, sizeof(block_t) * (BLOCK_BUFFER_DEPTH));
+  #endif
+
+  {
+    TERN_(PLANNER_BENCHMARK, BENCH_SCOPE(RECALCULATE));
+
+    // Blocks up to the planned one are already optimal
+    TERN_(INCREMENTAL_REPLANNING, block_buffer_stable = block_buffer_planned);
+
+    // Initialize block index to the last block in the planner buffer.
+    const uint8_t block_index = prev_block_index(block_buffer_head);
+    // If there is just one block, no planning can be done. Avoid it!
+    if (block_index != block_buffer_planned) {
+      reverse_pass();
+      forward_pass();
+    }
+    recalculate_trapezoids();
   }
-  recalculate_trapezoids();
+
+  TERN_(PLANNER_BENCHMARK, PlannerBenchmark::end_replan());
+
+  #if BOTH(INCREMENTAL_REPLANNING, PLANNER_BENCHMARK)
+    check_full_replan(planned_before);
+  #endif
 }
 
+#if ENABLED(EXTRUSION_FEEDFORWARD)
+
+  /**
+   * Time (s) a block takes along its trapezoid. Without a plateau the peak
+   * rate is the one reached at the end of acceleration.
+   */
+  static float trapezoid_time(const block_t * const block) {
+    const float accel = block->acceleration_steps_per_s2;
+    float time = float(block->decelerate_after - block->accelerate_until) / block->nominal_rate;
+    if (accel > 0) {
+      float peak_rate = block->decelerate_after > block->accelerate_until ? float(block->nominal_rate)
+                      : SQRT(sq(float(block->initial_rate)) + 2 * accel * block->accelerate_until);
+      NOLESS(peak_rate, float(_MAX(block->initial_rate, block->final_rate)));
+      time += (2 * peak_rate - block->initial_rate - block->final_rate) / accel;
+    }
+    return time;
+  }
+
+  /**
+   * Sum the filament volume the queued blocks feed in over the lookahead
+   * window, timing each block along its trapezoid. A retract cancels the
+   * recover that follows it, and time past the end of the queue extrudes
+   * nothing. The busy block counts in full, so the window may open up to
+   * one block early.
+   */
+  float Planner::extrusion_rate(const uint8_t e) {
+    constexpr float window = (EXTRUSION_LOOKAHEAD_MS) * 0.001f;
+    float time = 0, volume = 0;
+    for (uint8_t b = block_buffer_tail; b != block_buffer_head && time < window; b = next_block_index(b)) {
+      const block_t * const block = &block_buffer[b];
+      if (TEST(block->flag, BLOCK_BIT_SYNC_POSITION) || IS_PAGE(block) || !block->nominal_rate) continue;
+      const float block_time = trapezoid_time(block),
+                  share = _MIN(window - time, block_time) / block_time;
+      time += block_time;
+      #if HOTENDS > 1
+        if (block->extruder != e) continue;
+      #else
+        UNUSED(e);
+      #endif
+      const float e_mm3 = share * block->steps.e * steps_to_mm[E_AXIS_N(block->extruder)] * filament_area(block->extruder);
+      volume += TEST(block->direction_bits, E_AXIS) ? -e_mm3 : e_mm3;
+    }
+    return _MAX(volume, 0.0f) / window;
+  }
+
+#endif // EXTRUSION_FEEDFORWARD
+
 #if ENABLED(AUTOTEMP)
 
   void Planner::getHighESpeed() {
@@ -1570,6 +1818,7 @@ void Planner::quick_stop() {
 
   // Drop all queue entries
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
+  TERN_(STEP_SEGMENT_QUEUE, step_segments.reset());
 
   // Restart the block delay for the first movement - As the queue was
   // forced to empty, there's no risk the ISR will touch this.
@@ -1701,6 +1950,8 @@ bool Planner::_buffer_steps(const xyze_long_t &target
   // Move buffer head
   block_buffer_head = next_buffer_head;
 
+  TERN_(PLANNER_BENCHMARK, PlannerBenchmark::blocks++);
+
   // Recalculate and optimize trapezoidal speed profiles
   recalculate();
 
@@ -1729,6 +1980,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   #endif
   , feedRate_t fr_mm_s, const uint8_t extruder, const float &millimeters/*=0.0*/
 ) {
+  TERN_(PLANNER_BENCHMARK, BENCH_SCOPE(POPULATE_BLOCK));
 
   const int32_t da = target.a - position.a,
                 db = target.b - position.b,
@@ -2002,14 +2254,14 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
         #if HAS_DUPLICATION_MODE
           if (extruder_duplication_enabled && extruder == 0) {
             ENABLE_AXIS_E1();
-            g_uc_extruder_last_move[1] = (BLOCK_BUFFER_SIZE) * 2;
+            g_uc_extruder_last_move[1] = _MIN((BLOCK_BUFFER_DEPTH) * 2, 255);
           }
         #endif
 
         #define ENABLE_ONE_E(N) do{ \
           if (extruder == N) { \
             ENABLE_AXIS_E##N(); \
-            g_uc_extruder_last_move[N] = (BLOCK_BUFFER_SIZE) * 2; \
+            g_uc_extruder_last_move[N] = _MIN((BLOCK_BUFFER_DEPTH) * 2, 255); \
           } \
           else if (!g_uc_extruder_last_move[N]) \
             DISABLE_AXIS_E##N(); \
@@ -2049,11 +2301,17 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     #ifndef SLOWDOWN_DIVISOR
       #define SLOWDOWN_DIVISOR 2
     #endif
-    if (WITHIN(moves_queued, 2, (BLOCK_BUFFER_SIZE) / (SLOWDOWN_DIVISOR) - 1)) {
+    #if ENABLED(STEP_SEGMENT_QUEUE)
+      // Blocks frozen by the segment compiler are still waiting to run, so count them too
+      const uint8_t moves_waiting = movesplanned() - (block_buffer_tail != block_buffer_nonbusy);
+    #else
+      const uint8_t moves_waiting = moves_queued;
+    #endif
+    if (WITHIN(moves_waiting, 2, (BLOCK_BUFFER_DEPTH) / (SLOWDOWN_DIVISOR) - 1)) {
       const int32_t time_diff = settings.min_segment_time_us - segment_time_us;
       if (time_diff > 0) {
         // Buffer is draining so add extra time. The amount of time added increases if the buffer is still emptied more.
-        const int32_t nst = segment_time_us + LROUND(2 * time_diff / moves_queued);
+        const int32_t nst = segment_time_us + LROUND(2 * time_diff / moves_waiting);
         inverse_secs = 1000000.0f / nst;
         #if defined(XY_FREQUENCY_LIMIT) || HAS_SPI_LCD
           segment_time_us = nst;
@@ -2324,17 +2582,29 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
      * => normalize the complete junction vector.
      * Elsewise, when needed JD factors in the E component
      */
-    if (ENABLED(IS_CORE) || esteps > 0)
-      normalize_junction_vector(unit_vec);  // Normalize with XYZE components
-    else
-      unit_vec *= inverse_millimeters;      // Use pre-calculated (1 / SQRT(x^2 + y^2 + z^2))
+    #if ENABLED(VECTOR_JUNCTION_DEVIATION)
+      const vector_4 unit_v4 = (ENABLED(IS_CORE) || esteps > 0)
+        ? normalize_junction_vector(vector_4(unit_vec))
+        : vector_4(unit_vec) * inverse_millimeters;
+      unit_v4.store(unit_vec);
+    #else
+      if (ENABLED(IS_CORE) || esteps > 0)
+        normalize_junction_vector(unit_vec);  // Normalize with XYZE components
+      else
+        unit_vec *= inverse_millimeters;      // Use pre-calculated (1 / SQRT(x^2 + y^2 + z^2))
+    #endif
 
     // Skip first block or when previous_nominal_speed is used as a flag for homing and offset cycles.
     if (moves_queued && !UNEAR_ZERO(previous_nominal_speed_sqr)) {
       // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
       // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
-      float junction_cos_theta = (-prev_unit_vec.x * unit_vec.x) + (-prev_unit_vec.y * unit_vec.y)
-                               + (-prev_unit_vec.z * unit_vec.z) + (-prev_unit_vec.e * unit_vec.e);
+      #if ENABLED(VECTOR_JUNCTION_DEVIATION)
+        const vector_4 prev_unit_v4(prev_unit_vec);
+        float junction_cos_theta = -prev_unit_v4.dot(unit_v4);
+      #else
+        float junction_cos_theta = (-prev_unit_vec.x * unit_vec.x) + (-prev_unit_vec.y * unit_vec.y)
+                                 + (-prev_unit_vec.z * unit_vec.z) + (-prev_unit_vec.e * unit_vec.e);
+      #endif
 
       // NOTE: Computed without any expensive trig, sin() or acos(), by trig half angle identity of cos(theta).
       if (junction_cos_theta > 0.999999f) {
@@ -2344,15 +2614,40 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
       else {
         NOLESS(junction_cos_theta, -0.999999f); // Check for numerical round-off to avoid divide by zero.
 
-        // Convert delta vector to unit vector
-        xyze_float_t junction_unit_vec = unit_vec - prev_unit_vec;
-        normalize_junction_vector(junction_unit_vec);
+        #if ENABLED(VECTOR_JUNCTION_DEVIATION)
+          // Convert delta vector to unit vector
+          const vector_4 junction_unit_vec = normalize_junction_vector(unit_v4 - prev_unit_v4);
 
-        const float junction_acceleration = limit_value_by_axis_maximum(block->acceleration, junction_unit_vec),
-                    sin_theta_d2 = SQRT(0.5f * (1.0f - junction_cos_theta)); // Trig half angle identity. Always positive.
+          const float junction_acceleration = limit_value_by_axis_maximum(block->acceleration, junction_unit_vec),
+                      sin_theta_d2 = fast_sqrt(0.5f * (1.0f - junction_cos_theta)); // Trig half angle identity. Always positive.
+        #else
+          // Convert delta vector to unit vector
+          xyze_float_t junction_unit_vec = unit_vec - prev_unit_vec;
+          normalize_junction_vector(junction_unit_vec);
+
+          const float junction_acceleration = limit_value_by_axis_maximum(block->acceleration, junction_unit_vec),
+                      sin_theta_d2 = SQRT(0.5f * (1.0f - junction_cos_theta)); // Trig half angle identity. Always positive.
+        #endif
 
         vmax_junction_sqr = junction_acceleration * junction_deviation_mm * sin_theta_d2 / (1.0f - sin_theta_d2);
 
+        #if BOTH(VECTOR_JUNCTION_DEVIATION, PLANNER_BENCHMARK)
+          {
+            // Check against the scalar junction math
+            xyze_float_t ref_unit_vec = unit_vec - prev_unit_vec;
+            normalize_junction_vector(ref_unit_vec);
+            const float ref_cos_theta = _MAX(-0.999999f, (-prev_unit_vec.x * unit_vec.x) + (-prev_unit_vec.y * unit_vec.y)
+                                                       + (-prev_unit_vec.z * unit_vec.z) + (-prev_unit_vec.e * unit_vec.e)),
+                        ref_sin_theta_d2 = SQRT(0.5f * (1.0f - ref_cos_theta));
+            const float ref_vmax_junction_sqr = limit_value_by_axis_maximum(block->acceleration, ref_unit_vec) * junction_deviation_mm * ref_sin_theta_d2 / (1.0f - ref_sin_theta_d2);
+            // Near-straight junctions are only limited by the nominal speeds
+            PlannerBenchmark::check_junction(
+              _MIN(vmax_junction_sqr, block->nominal_speed_sqr, previous_nominal_speed_sqr),
+              _MIN(ref_vmax_junction_sqr, block->nominal_speed_sqr, previous_nominal_speed_sqr)
+            );
+          }
+        #endif
+
         #if ENABLED(JD_HANDLE_SMALL_SEGMENTS)
 
           // For small moves with >135° junction (octagon) find speed for approximate arc
@@ -2739,6 +3034,8 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
     , const float &inv_duration
   #endif
 ) {
+  TERN_(PLANNER_BENCHMARK, BENCH_SCOPE(BUFFER_LINE));
+
   xyze_pos_t machine = { rx, ry, rz, e };
   TERN_(HAS_POSITION_MODIFIERS, apply_modifiers(machine));
 
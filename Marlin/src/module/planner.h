@@ -54,6 +54,10 @@
   #include "../libs/vector_3.h" // for matrix_3x3
 #endif
 
+#if ENABLED(VECTOR_JUNCTION_DEVIATION)
+  #include "../libs/vector_4.h"
+#endif
+
 #if ENABLED(FWRETRACT)
   #include "../feature/fwretract.h"
 #endif
@@ -236,7 +240,14 @@ typedef struct block_t {
   #define HAS_POSITION_FLOAT 1
 #endif
 
-#define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
+#if ENABLED(ADAPTIVE_BLOCK_BUFFER)
+  // The ring is sized at boot, so wrap with the mask chosen then
+  #define BLOCK_MOD(n) ((n)&(Planner::block_buffer_mask))
+  #define BLOCK_BUFFER_DEPTH Planner::block_buffer_size
+#else
+  #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
+  #define BLOCK_BUFFER_DEPTH (BLOCK_BUFFER_SIZE)
+#endif
 
 #if ENABLED(LASER_POWER_INLINE)
   typedef struct {
@@ -303,7 +314,13 @@ class Planner {
      *  Writer of head is Planner::buffer_segment().
      *  Reader of tail is Stepper::isr(). Always consider tail busy / read-only
      */
-    static block_t block_buffer[BLOCK_BUFFER_SIZE];
+    #if ENABLED(ADAPTIVE_BLOCK_BUFFER)
+      static block_t *block_buffer;                 // Allocated by allocate_block_buffer() at boot
+      static uint8_t block_buffer_size,             // Blocks in the ring, a power of 2
+                     block_buffer_mask;             // block_buffer_size - 1
+    #else
+      static block_t block_buffer[BLOCK_BUFFER_SIZE];
+    #endif
     static volatile uint8_t block_buffer_head,      // Index of the next block to be pushed
                             block_buffer_nonbusy,   // Index of the first non busy block
                             block_buffer_planned,   // Index of the optimally planned block
@@ -442,6 +459,13 @@ class Planner {
       volatile static uint32_t block_buffer_runtime_us; // Theoretical block buffer runtime in µs
     #endif
 
+    #if ENABLED(INCREMENTAL_REPLANNING)
+      static uint8_t block_buffer_stable;           // Index of the newest block whose entry speed the current replan can't change
+      #if ENABLED(PLANNER_BENCHMARK)
+        static bool full_replan;                    // Replan every block, for the benchmark's shadow check
+      #endif
+    #endif
+
   public:
 
     /**
@@ -627,6 +651,11 @@ class Planner {
     // Number of nonbusy moves currently in the planner
     FORCE_INLINE static uint8_t nonbusy_movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_nonbusy); }
 
+    #if ENABLED(ADAPTIVE_BLOCK_BUFFER)
+      // Size the ring from the free RAM at boot, before any move is queued
+      static void allocate_block_buffer();
+    #endif
+
     // Remove all blocks from the buffer
     FORCE_INLINE static void clear_block_buffer() { block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail = 0; }
 
@@ -634,7 +663,7 @@ class Planner {
     FORCE_INLINE static bool is_full() { return block_buffer_tail == next_block_index(block_buffer_head); }
 
     // Get count of movement slots free
-    FORCE_INLINE static uint8_t moves_free() { return BLOCK_BUFFER_SIZE - 1 - movesplanned(); }
+    FORCE_INLINE static uint8_t moves_free() { return BLOCK_BUFFER_DEPTH - 1 - movesplanned(); }
 
     /**
      * Planner::get_next_free_block
@@ -862,6 +891,21 @@ class Planner {
      */
     static block_t* get_current_block();
 
+    #if ENABLED(STEP_SEGMENT_QUEUE)
+      /**
+       * With the segment queue, blocks become busy when the segment compiler
+       * freezes them, ahead of the Stepper ISR (or when the Stepper ISR takes
+       * one the compiler hasn't reached). Frozen blocks are those from the
+       * tail up to (but not including) block_buffer_nonbusy.
+       */
+      static block_t* peek_nonbusy_block();
+      static void freeze_nonbusy_block();
+      FORCE_INLINE static bool is_block_frozen(const uint8_t block_index) {
+        const uint8_t tail = block_buffer_tail;
+        return BLOCK_MOD(block_index - tail) < BLOCK_MOD(block_buffer_nonbusy - tail);
+      }
+    #endif
+
     /**
      * "Release" the current block so its slot can be reused.
      * Called when the current block is no longer needed.
@@ -876,6 +920,24 @@ class Planner {
       static void clear_block_buffer_runtime();
     #endif
 
+    #if ENABLED(EXTRUSION_FEEDFORWARD)
+      /**
+       * Filament volume per second (mm³/s) the queued moves will extrude
+       * for a hotend over the next EXTRUSION_LOOKAHEAD_MS
+       */
+      static float extrusion_rate(const uint8_t e);
+
+      // Cross-section of an extruder's filament, from the M200 diameter
+      FORCE_INLINE static float filament_area(const uint8_t e) {
+        #if DISABLED(NO_VOLUMETRICS)
+          if (filament_size[e] > 0) return CIRCLE_AREA(filament_size[e] * 0.5f);
+        #else
+          UNUSED(e);
+        #endif
+        return CIRCLE_AREA(float(DEFAULT_NOMINAL_FILAMENT_DIA) * 0.5f);
+      }
+    #endif
+
     #if ENABLED(AUTOTEMP)
       static float autotemp_min, autotemp_max, autotemp_factor;
       static bool autotemp_enabled;
@@ -897,8 +959,13 @@ class Planner {
     /**
      * Get the index of the next / previous block in the ring buffer
      */
-    static constexpr uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
-    static constexpr uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
+    #if ENABLED(ADAPTIVE_BLOCK_BUFFER)
+      FORCE_INLINE static uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
+      FORCE_INLINE static uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
+    #else
+      static constexpr uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
+      static constexpr uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
+    #endif
 
     /**
      * Calculate the distance (not time) it takes to accelerate
@@ -952,6 +1019,10 @@ class Planner {
 
     static void recalculate();
 
+    #if BOTH(INCREMENTAL_REPLANNING, PLANNER_BENCHMARK)
+      static void check_full_replan(const uint8_t planned_before);
+    #endif
+
     #if HAS_JUNCTION_DEVIATION
 
       FORCE_INLINE static void normalize_junction_vector(xyze_float_t &vector) {
@@ -971,6 +1042,31 @@ class Planner {
         return limit_value;
       }
 
+      #if ENABLED(VECTOR_JUNCTION_DEVIATION)
+
+        FORCE_INLINE static vector_4 normalize_junction_vector(const vector_4 &vector) {
+          return vector * fast_rsqrt(vector.dot(vector));
+        }
+
+        FORCE_INLINE static float limit_value_by_axis_maximum(const float &max_value, const vector_4 &unit_vec) {
+          const vector_4 max_accel(settings.max_acceleration_mm_per_s2[X_AXIS], settings.max_acceleration_mm_per_s2[Y_AXIS],
+                                   settings.max_acceleration_mm_per_s2[Z_AXIS], settings.max_acceleration_mm_per_s2[E_AXIS]);
+          #ifdef __SSE__
+            return (max_accel / unit_vec.absolute()).min_lane(max_value); // One DIVPS. Zero lanes give infinity
+          #else
+            // Each lane would be its own divide (a soft-float call without an FPU),
+            // so as in the scalar code only divide the lanes that exceed their limit
+            const vector_4 abs_vec = unit_vec.absolute();
+            float limit_value = max_value;
+            LOOP_XYZE(idx)
+              if (limit_value * abs_vec.v[idx] > max_accel.v[idx])
+                limit_value = max_accel.v[idx] / abs_vec.v[idx];
+            return limit_value;
+          #endif
+        }
+
+      #endif
+
     #endif // !CLASSIC_JERK
 };
 
@@ -136,6 +136,14 @@ Stepper stepper; // Singleton
   #include "../feature/spindle_laser.h"
 #endif
 
+#if ENABLED(STEP_SEGMENT_QUEUE)
+  #include "../feature/step_segments.h"
+#endif
+
+#if ENABLED(ISR_PROFILER)
+  #include "../feature/isr_profiler.h"
+#endif
+
 // public:
 
 #if EITHER(HAS_EXTRA_ENDSTOPS, Z_STEPPER_AUTO_ALIGN)
@@ -207,6 +215,9 @@ uint32_t Stepper::advance_divisor = 0,
     bool __attribute__((used)) Stepper::A_negative __asm__("A_negative"); // If A coefficient was negative
   #endif
   bool Stepper::bezier_2nd_half;    // =false If Bézier curve has been initialized or not
+  #if ENABLED(STEP_SEGMENT_QUEUE)
+    uint8_t Stepper::fallback_bezier_phase; // =0 Set up by fallback_step_rate() when the segments run out
+  #endif
 #endif
 
 #if ENABLED(LIN_ADVANCE)
@@ -234,6 +245,9 @@ uint32_t Stepper::advance_divisor = 0,
 int32_t Stepper::ticks_nominal = -1;
 #if DISABLED(S_CURVE_ACCELERATION)
   uint32_t Stepper::acc_step_rate; // needed for deceleration start point
+  #if ENABLED(STEP_SEGMENT_QUEUE)
+    uint32_t Stepper::accel_peak_time;
+  #endif
 #endif
 
 xyz_long_t Stepper::endstops_trigsteps;
@@ -1345,13 +1359,8 @@ HAL_STEP_TIMER_ISR() {
   HAL_timer_isr_epilogue(STEP_TIMER_NUM);
 }
 
-#ifdef CPU_32_BIT
-  #define STEP_MULTIPLY(A,B) MultiU32X24toH32(A, B)
-#else
-  #define STEP_MULTIPLY(A,B) MultiU24X32toH16(A, B)
-#endif
-
 void Stepper::isr() {
+  TERN_(ISR_PROFILER, ISR_PROFILE(STEPPER));
 
   static uint32_t nextMainISR = 0;  // Interval until the next main Stepper Pulse phase (0 = Now)
 
@@ -1517,6 +1526,7 @@ void Stepper::isr() {
  * is to keep pulse timing as regular as possible.
  */
 void Stepper::pulse_phase_isr() {
+  TERN_(ISR_PROFILER, ISR_PROFILE(PULSE_PHASE));
 
   // If we must abort the current block, do so!
   if (abort_current_block) {
@@ -1555,19 +1565,57 @@ void Stepper::pulse_phase_isr() {
       } \
     }while(0)
 
-    // Start an active pulse if needed
-    #define PULSE_START(AXIS) do{ \
-      if (step_needed[_AXIS(AXIS)]) { \
-        _APPLY_STEP(AXIS, !_INVERT_STEP_PIN(AXIS), 0); \
-      } \
-    }while(0)
+    #if ENABLED(BATCHED_STEP_PULSES)
+
+      // Start an active pulse if needed. Batched axes add their pin to the mask of their group.
+      #define PULSE_START(AXIS) do{ \
+        if (step_needed[_AXIS(AXIS)]) { \
+          if (step_pin_batched(_AXIS(AXIS))) \
+            step_port_bits[step_port_lead(_AXIS(AXIS))] |= step_port_mask(_AXIS(AXIS)); \
+          else \
+            _APPLY_STEP(AXIS, !_INVERT_STEP_PIN(AXIS), 0); \
+        } \
+      }while(0)
+
+      // Stop an active pulse if needed. Batched axes are stopped by PORT_PULSE_STOP.
+      #define PULSE_STOP(AXIS) do { \
+        if (step_needed[_AXIS(AXIS)] && !step_pin_batched(_AXIS(AXIS))) { \
+          _APPLY_STEP(AXIS, _INVERT_STEP_PIN(AXIS), 0); \
+        } \
+      }while(0)
+
+      // Start / stop the pulses of a whole group with one port write, from its lead axis
+      #define _IS_PORT_LEAD(AXIS) (step_pin_batched(_AXIS(AXIS)) && step_port_lead(_AXIS(AXIS)) == _AXIS(AXIS))
+      #define _PORT_WRITE(AXIS, V) do{ \
+        if (V) WRITE_PORT_SET(step_port(_AXIS(AXIS)), step_port_bits[_AXIS(AXIS)]); \
+        else   WRITE_PORT_CLR(step_port(_AXIS(AXIS)), step_port_bits[_AXIS(AXIS)]); \
+      }while(0)
+      #define PORT_PULSE_START(AXIS) do{ \
+        if (_IS_PORT_LEAD(AXIS) && step_port_bits[_AXIS(AXIS)]) _PORT_WRITE(AXIS, !_INVERT_STEP_PIN(AXIS)); \
+      }while(0)
+      #define PORT_PULSE_STOP(AXIS) do{ \
+        if (_IS_PORT_LEAD(AXIS) && step_port_bits[_AXIS(AXIS)]) _PORT_WRITE(AXIS, _INVERT_STEP_PIN(AXIS)); \
+      }while(0)
+
+      xyze_ulong_t step_port_bits{0};   // Step pins to write for each group, this iteration
 
-    // Stop an active pulse if needed
-    #define PULSE_STOP(AXIS) do { \
-      if (step_needed[_AXIS(AXIS)]) { \
-        _APPLY_STEP(AXIS, _INVERT_STEP_PIN(AXIS), 0); \
-      } \
-    }while(0)
+    #else
+
+      // Start an active pulse if needed
+      #define PULSE_START(AXIS) do{ \
+        if (step_needed[_AXIS(AXIS)]) { \
+          _APPLY_STEP(AXIS, !_INVERT_STEP_PIN(AXIS), 0); \
+        } \
+      }while(0)
+
+      // Stop an active pulse if needed
+      #define PULSE_STOP(AXIS) do { \
+        if (step_needed[_AXIS(AXIS)]) { \
+          _APPLY_STEP(AXIS, _INVERT_STEP_PIN(AXIS), 0); \
+        } \
+      }while(0)
+
+    #endif
 
     // Direct Stepping page?
     const bool is_page = IS_PAGE(current_block);
@@ -1736,6 +1784,13 @@ void Stepper::pulse_phase_isr() {
       #endif
     #endif
 
+    #if ENABLED(BATCHED_STEP_PULSES)
+      PORT_PULSE_START(X);
+      PORT_PULSE_START(Y);
+      PORT_PULSE_START(Z);
+      PORT_PULSE_START(E);
+    #endif
+
     #if ENABLED(I2S_STEPPER_STREAM)
       i2s_push_sample();
     #endif
@@ -1768,6 +1823,13 @@ void Stepper::pulse_phase_isr() {
       #endif
     #endif
 
+    #if ENABLED(BATCHED_STEP_PULSES)
+      PORT_PULSE_STOP(X);
+      PORT_PULSE_STOP(Y);
+      PORT_PULSE_STOP(Z);
+      PORT_PULSE_STOP(E);
+    #endif
+
     #if ISR_MULTI_STEPS
       if (events_to_do) START_LOW_PULSE();
     #endif
@@ -1775,11 +1837,51 @@ void Stepper::pulse_phase_isr() {
   } while (--events_to_do);
 }
 
+#if ENABLED(STEP_SEGMENT_QUEUE)
+
+  /**
+   * The step rate on the current block's own trapezoid, for when the segment
+   * compiler has fallen behind. Only the phase times are kept up to date while
+   * segments are used, so the Bézier curve is set up on the first call in each
+   * phase and only evaluated after that.
+   */
+  uint32_t Stepper::fallback_step_rate() {
+    const bool decelerating = step_events_completed > decelerate_after;
+    if (!decelerating && step_events_completed > accelerate_until) return current_block->nominal_rate;
+
+    #if ENABLED(S_CURVE_ACCELERATION)
+      if (!decelerating) {
+        if (acceleration_time >= current_block->acceleration_time) return current_block->cruise_rate;
+        if (fallback_bezier_phase != 1) {
+          _calc_bezier_curve_coeffs(current_block->initial_rate, current_block->cruise_rate, current_block->acceleration_time_inverse);
+          fallback_bezier_phase = 1;
+        }
+        return _eval_bezier_curve(acceleration_time);
+      }
+      if (deceleration_time >= current_block->deceleration_time) return current_block->final_rate;
+      if (fallback_bezier_phase != 2) {
+        _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+        fallback_bezier_phase = 2;
+      }
+      return _eval_bezier_curve(deceleration_time);
+    #else
+      // Accelerate from the time so far, or decelerate from the rate of the last accelerating call
+      uint32_t peak_rate = STEP_MULTIPLY(decelerating ? accel_peak_time : acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
+      NOMORE(peak_rate, current_block->nominal_rate);
+      if (!decelerating) return peak_rate;
+      const uint32_t dv = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
+      return dv < peak_rate ? _MAX(peak_rate - dv, current_block->final_rate) : current_block->final_rate;
+    #endif
+  }
+
+#endif
+
 // This is the last half of the stepper interrupt: This one processes and
 // properly schedules blocks from the planner. This is executed after creating
 // the step pulses, so it is not time critical, as pulses are already done.
 
 uint32_t Stepper::block_phase_isr() {
+  TERN_(ISR_PROFILER, ISR_PROFILE(BLOCK_PHASE));
 
   // If no queued movements, just wait 1ms for the next block
   uint32_t interval = (STEPPER_TIMER_RATE) / 1000UL;
@@ -1814,21 +1916,31 @@ uint32_t Stepper::block_phase_isr() {
       // Are we in acceleration phase ?
       if (step_events_completed <= accelerate_until) { // Calculate new timer value
 
-        #if ENABLED(S_CURVE_ACCELERATION)
-          // Get the next speed to use (Jerk limited!)
-          uint32_t acc_step_rate = acceleration_time < current_block->acceleration_time
-                                   ? _eval_bezier_curve(acceleration_time)
-                                   : current_block->cruise_rate;
+        #if ENABLED(STEP_SEGMENT_QUEUE)
+          // The segment compiler did the math, unless it fell behind
+          if (!step_segments.next_interval(step_events_completed, interval, steps_per_isr))
+            interval = calc_timer_interval(fallback_step_rate(), &steps_per_isr);
+          #if DISABLED(S_CURVE_ACCELERATION)
+            accel_peak_time = acceleration_time; // Only the last one is kept, for the deceleration fallback
+          #endif
+          acceleration_time += interval;
         #else
-          acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
-          NOMORE(acc_step_rate, current_block->nominal_rate);
-        #endif
+          #if ENABLED(S_CURVE_ACCELERATION)
+            // Get the next speed to use (Jerk limited!)
+            uint32_t acc_step_rate = acceleration_time < current_block->acceleration_time
+                                     ? _eval_bezier_curve(acceleration_time)
+                                     : current_block->cruise_rate;
+          #else
+            acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
+            NOMORE(acc_step_rate, current_block->nominal_rate);
+          #endif
 
-        // acc_step_rate is in steps/second
+          // acc_step_rate is in steps/second
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(acc_step_rate, &steps_per_isr);
-        acceleration_time += interval;
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(acc_step_rate, &steps_per_isr);
+          acceleration_time += interval;
+        #endif
 
         #if ENABLED(LIN_ADVANCE)
           if (LA_use_advance_lead) {
@@ -1869,40 +1981,47 @@ uint32_t Stepper::block_phase_isr() {
       }
       // Are we in Deceleration phase ?
       else if (step_events_completed > decelerate_after) {
-        uint32_t step_rate;
 
-        #if ENABLED(S_CURVE_ACCELERATION)
-          // If this is the 1st time we process the 2nd half of the trapezoid...
-          if (!bezier_2nd_half) {
-            // Initialize the Bézier speed curve
-            _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
-            bezier_2nd_half = true;
-            // The first point starts at cruise rate. Just save evaluation of the Bézier curve
-            step_rate = current_block->cruise_rate;
-          }
-          else {
-            // Calculate the next speed to use
-            step_rate = deceleration_time < current_block->deceleration_time
-              ? _eval_bezier_curve(deceleration_time)
-              : current_block->final_rate;
-          }
+        #if ENABLED(STEP_SEGMENT_QUEUE)
+          if (!step_segments.next_interval(step_events_completed, interval, steps_per_isr))
+            interval = calc_timer_interval(fallback_step_rate(), &steps_per_isr);
+          deceleration_time += interval;
         #else
+          uint32_t step_rate;
+
+          #if ENABLED(S_CURVE_ACCELERATION)
+            // If this is the 1st time we process the 2nd half of the trapezoid...
+            if (!bezier_2nd_half) {
+              // Initialize the Bézier speed curve
+              _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+              bezier_2nd_half = true;
+              // The first point starts at cruise rate. Just save evaluation of the Bézier curve
+              step_rate = current_block->cruise_rate;
+            }
+            else {
+              // Calculate the next speed to use
+              step_rate = deceleration_time < current_block->deceleration_time
+                ? _eval_bezier_curve(deceleration_time)
+                : current_block->final_rate;
+            }
+          #else
 
-          // Using the old trapezoidal control
-          step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
-          if (step_rate < acc_step_rate) { // Still decelerating?
-            step_rate = acc_step_rate - step_rate;
-            NOLESS(step_rate, current_block->final_rate);
-          }
-          else
-            step_rate = current_block->final_rate;
-        #endif
+            // Using the old trapezoidal control
+            step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
+            if (step_rate < acc_step_rate) { // Still decelerating?
+              step_rate = acc_step_rate - step_rate;
+              NOLESS(step_rate, current_block->final_rate);
+            }
+            else
+              step_rate = current_block->final_rate;
+          #endif
 
-        // step_rate is in steps/second
+          // step_rate is in steps/second
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(step_rate, &steps_per_isr);
-        deceleration_time += interval;
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(step_rate, &steps_per_isr);
+          deceleration_time += interval;
+        #endif
 
         #if ENABLED(LIN_ADVANCE)
           if (LA_use_advance_lead) {
@@ -1952,14 +2071,19 @@ uint32_t Stepper::block_phase_isr() {
           if (LA_steps && LA_isr_rate != current_block->advance_speed) initiateLA();
         #endif
 
-        // Calculate the ticks_nominal for this nominal speed, if not done yet
-        if (ticks_nominal < 0) {
-          // step_rate to timer interval and loops for the nominal speed
-          ticks_nominal = calc_timer_interval(current_block->nominal_rate, &steps_per_isr);
-        }
+        #if ENABLED(STEP_SEGMENT_QUEUE)
+          if (!step_segments.next_interval(step_events_completed, interval, steps_per_isr))
+            interval = calc_timer_interval(current_block->nominal_rate, &steps_per_isr);
+        #else
+          // Calculate the ticks_nominal for this nominal speed, if not done yet
+          if (ticks_nominal < 0) {
+            // step_rate to timer interval and loops for the nominal speed
+            ticks_nominal = calc_timer_interval(current_block->nominal_rate, &steps_per_isr);
+          }
 
-        // The timer interval is just the nominal value for the nominal speed
-        interval = ticks_nominal;
+          // The timer interval is just the nominal value for the nominal speed
+          interval = ticks_nominal;
+        #endif
 
         // Update laser - Cruising
         #if ENABLED(LASER_POWER_INLINE_TRAPEZOID)
@@ -2097,14 +2221,8 @@ uint32_t Stepper::block_phase_isr() {
       acceleration_time = deceleration_time = 0;
 
       #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
-        uint8_t oversampling = 0;                           // Assume no axis smoothing (via oversampling)
-        // Decide if axis smoothing is possible
-        uint32_t max_rate = current_block->nominal_rate;    // Get the maximum rate (maximum event speed)
-        while (max_rate < MIN_STEP_ISR_FREQUENCY) {         // As long as more ISRs are possible...
-          max_rate <<= 1;                                   // Try to double the rate
-          if (max_rate >= MAX_STEP_ISR_FREQUENCY_1X) break; // Don't exceed the estimated ISR limit
-          ++oversampling;                                   // Increase the oversampling (used for left-shift)
-        }
+        // Decide if axis smoothing is possible, based on the maximum rate (maximum event speed)
+        const uint8_t oversampling = calc_oversampling(current_block->nominal_rate);
         oversampling_factor = oversampling;                 // For all timer interval calculations
       #else
         constexpr uint8_t oversampling = 0;
@@ -2211,21 +2329,37 @@ uint32_t Stepper::block_phase_isr() {
         if (current_block->steps.z) ENABLE_AXIS_Z();
       #endif
 
-      // Mark the time_nominal as not calculated yet
-      ticks_nominal = -1;
+      #if ENABLED(STEP_SEGMENT_QUEUE)
+
+        // Get the first interval from the segments of this block
+        step_segments.start_block(planner.block_buffer_tail);
+        #if ENABLED(S_CURVE_ACCELERATION)
+          fallback_bezier_phase = 0; // No Bézier curve set up for this block yet
+        #else
+          accel_peak_time = 0;       // Decelerate from the initial rate if there are no accelerating calls
+        #endif
+        if (!step_segments.next_interval(0, interval, steps_per_isr))
+          interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr);
 
-      #if ENABLED(S_CURVE_ACCELERATION)
-        // Initialize the Bézier speed curve
-        _calc_bezier_curve_coeffs(current_block->initial_rate, current_block->cruise_rate, current_block->acceleration_time_inverse);
-        // We haven't started the 2nd half of the trapezoid
-        bezier_2nd_half = false;
       #else
-        // Set as deceleration point the initial rate of the block
-        acc_step_rate = current_block->initial_rate;
-      #endif
 
-      // Calculate the initial timer interval
-      interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr);
+        // Mark the time_nominal as not calculated yet
+        ticks_nominal = -1;
+
+        #if ENABLED(S_CURVE_ACCELERATION)
+          // Initialize the Bézier speed curve
+          _calc_bezier_curve_coeffs(current_block->initial_rate, current_block->cruise_rate, current_block->acceleration_time_inverse);
+          // We haven't started the 2nd half of the trapezoid
+          bezier_2nd_half = false;
+        #else
+          // Set as deceleration point the initial rate of the block
+          acc_step_rate = current_block->initial_rate;
+        #endif
+
+        // Calculate the initial timer interval
+        interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr);
+
+      #endif
     }
     #if ENABLED(LASER_POWER_INLINE_CONTINUOUS)
       else { // No new block found; so apply inline laser parameters
@@ -2252,6 +2386,7 @@ uint32_t Stepper::block_phase_isr() {
 
   // Timer interrupt for E. LA_steps is set in the main routine
   uint32_t Stepper::advance_isr() {
+    TERN_(ISR_PROFILER, ISR_PROFILE(ADVANCE));
     uint32_t interval;
 
     if (LA_use_advance_lead) {
@@ -2357,28 +2492,37 @@ uint32_t Stepper::block_phase_isr() {
 // The current_block could change in the middle of the read by an Stepper ISR, so
 // we must explicitly prevent that!
 bool Stepper::is_block_busy(const block_t* const block) {
-  #ifdef __AVR__
-    // A SW memory barrier, to ensure GCC does not overoptimize loops
-    #define sw_barrier() asm volatile("": : :"memory");
-
-    // Keep reading until 2 consecutive reads return the same value,
-    // meaning there was no update in-between caused by an interrupt.
-    // This works because stepper ISRs happen at a slower rate than
-    // successive reads of a variable, so 2 consecutive reads with
-    // the same value means no interrupt updated it.
-    block_t* vold, *vnew = current_block;
-    sw_barrier();
-    do {
-      vold = vnew;
-      vnew = current_block;
-      sw_barrier();
-    } while (vold != vnew);
+  #if ENABLED(STEP_SEGMENT_QUEUE)
+
+    // The segment compiler makes blocks busy ahead of the Stepper ISR
+    return planner.is_block_frozen(block - planner.block_buffer);
+
   #else
-    block_t *vnew = current_block;
-  #endif
 
-  // Return if the block is busy or not
-  return block == vnew;
+    #ifdef __AVR__
+      // A SW memory barrier, to ensure GCC does not overoptimize loops
+      #define sw_barrier() asm volatile("": : :"memory");
+
+      // Keep reading until 2 consecutive reads return the same value,
+      // meaning there was no update in-between caused by an interrupt.
+      // This works because stepper ISRs happen at a slower rate than
+      // successive reads of a variable, so 2 consecutive reads with
+      // the same value means no interrupt updated it.
+      block_t* vold, *vnew = current_block;
+      sw_barrier();
+      do {
+        vold = vnew;
+        vnew = current_block;
+        sw_barrier();
+      } while (vold != vnew);
+    #else
+      block_t *vnew = current_block;
+    #endif
+
+    // Return if the block is busy or not
+    return block == vnew;
+
+  #endif
 }
 
 void Stepper::init() {
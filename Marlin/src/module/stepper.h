@@ -45,6 +45,9 @@
 
 #include "planner.h"
 #include "stepper/indirection.h"
+#if ENABLED(BATCHED_STEP_PULSES)
+  #include "../pins/stepper_ports.h"
+#endif
 #ifdef __AVR__
   #include "speed_lookuptable.h"
 #endif
@@ -52,6 +55,13 @@
 // Disable multiple steps per ISR
 //#define DISABLE_MULTI_STEPPING
 
+// Rate change over a time in timer ticks, at an acceleration rate from the planner (<< 24)
+#ifdef CPU_32_BIT
+  #define STEP_MULTIPLY(A,B) MultiU32X24toH32(A, B)
+#else
+  #define STEP_MULTIPLY(A,B) MultiU24X32toH16(A, B)
+#endif
+
 //
 // Estimate the amount of time the Stepper ISR will take to execute
 //
@@ -237,6 +247,10 @@
 //
 class Stepper {
 
+  #if ENABLED(STEP_SEGMENT_QUEUE)
+    friend class StepSegmentQueue;
+  #endif
+
   public:
 
     #if EITHER(HAS_EXTRA_ENDSTOPS, Z_STEPPER_AUTO_ALIGN)
@@ -318,6 +332,9 @@ class Stepper {
         static bool A_negative;    // If A coefficient was negative
       #endif
       static bool bezier_2nd_half; // If Bézier curve has been initialized or not
+      #if ENABLED(STEP_SEGMENT_QUEUE)
+        static uint8_t fallback_bezier_phase; // The phase the Bézier curve is set up for: 0 none, 1 acceleration, 2 deceleration
+      #endif
     #endif
 
     #if ENABLED(LIN_ADVANCE)
@@ -340,6 +357,9 @@ class Stepper {
     static int32_t ticks_nominal;
     #if DISABLED(S_CURVE_ACCELERATION)
       static uint32_t acc_step_rate; // needed for deceleration start point
+      #if ENABLED(STEP_SEGMENT_QUEUE)
+        static uint32_t accel_peak_time; // Acceleration time of the last accelerating ISR call, where acc_step_rate was taken
+      #endif
     #endif
 
     // Exact steps at which an endstop was triggered
@@ -520,11 +540,24 @@ class Stepper {
     static void _set_position(const int32_t &a, const int32_t &b, const int32_t &c, const int32_t &e);
     FORCE_INLINE static void _set_position(const abce_long_t &spos) { _set_position(spos.a, spos.b, spos.c, spos.e); }
 
-    FORCE_INLINE static uint32_t calc_timer_interval(uint32_t step_rate, uint8_t* loops) {
+    #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+      // Get the oversampling for a block, raising slow step rates up to MIN_STEP_ISR_FREQUENCY
+      FORCE_INLINE static uint8_t calc_oversampling(uint32_t max_rate) {
+        uint8_t oversampling = 0;                           // Assume no axis smoothing (via oversampling)
+        while (max_rate < MIN_STEP_ISR_FREQUENCY) {         // As long as more ISRs are possible...
+          max_rate <<= 1;                                   // Try to double the rate
+          if (max_rate >= MAX_STEP_ISR_FREQUENCY_1X) break; // Don't exceed the estimated ISR limit
+          ++oversampling;                                   // Increase the oversampling (used for left-shift)
+        }
+        return oversampling;
+      }
+    #endif
+
+    FORCE_INLINE static uint32_t calc_timer_interval(uint32_t step_rate, uint8_t* loops, const uint8_t oversampling=oversampling_factor) {
       uint32_t timer;
 
       // Scale the frequency, as requested by the caller
-      step_rate <<= oversampling_factor;
+      step_rate <<= oversampling;
 
       uint8_t multistep = 1;
       #if DISABLED(DISABLE_MULTI_STEPPING)
@@ -585,6 +618,10 @@ class Stepper {
       static int32_t _eval_bezier_curve(const uint32_t curr_step);
     #endif
 
+    #if ENABLED(STEP_SEGMENT_QUEUE)
+      static uint32_t fallback_step_rate();
+    #endif
+
     #if HAS_DIGIPOTSS || HAS_MOTOR_CURRENT_PWM
       static void digipot_init();
     #endif
@@ -73,10 +73,15 @@
   #include "../libs/private_spi.h"
 #endif
 
-#if ENABLED(PID_EXTRUSION_SCALING)
+#if EITHER(PID_EXTRUSION_SCALING, MPCTEMP)
   #include "stepper.h"
 #endif
 
+#if ENABLED(EXTRUSION_FEEDFORWARD)
+  // PID Kc and the MPC filament heat capacity are per mm of filament of the nominal diameter
+  constexpr float nominal_filament_area = CIRCLE_AREA(float(DEFAULT_NOMINAL_FILAMENT_DIA) * 0.5f);
+#endif
+
 #if ENABLED(BABYSTEPPING) && DISABLED(INTEGRATED_BABYSTEPPING)
   #include "../feature/babystep.h"
 #endif
@@ -111,15 +116,26 @@
   #include "../libs/buzzer.h"
 #endif
 
+#if ENABLED(ISR_PROFILER)
+  #include "../feature/isr_profiler.h"
+#endif
+
 #if HOTEND_USES_THERMISTOR
   #if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
     static const temp_entry_t* heater_ttbl_map[2] = { HEATER_0_TEMPTABLE, HEATER_1_TEMPTABLE };
     static constexpr uint8_t heater_ttbllen_map[2] = { HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN };
+    #if ENABLED(FAST_THERMISTOR_LOOKUP)
+      static const uint8_t* heater_ttgrid_map[2] = { TT_GRID(HEATER_0_TEMPTABLE, HEATER_0_TEMPTABLE_LEN), TT_GRID(HEATER_1_TEMPTABLE, HEATER_1_TEMPTABLE_LEN) };
+    #endif
   #else
     #define NEXT_TEMPTABLE(N) ,HEATER_##N##_TEMPTABLE
     #define NEXT_TEMPTABLE_LEN(N) ,HEATER_##N##_TEMPTABLE_LEN
     static const temp_entry_t* heater_ttbl_map[HOTENDS] = ARRAY_BY_HOTENDS(HEATER_0_TEMPTABLE REPEAT_S(1, HOTENDS, NEXT_TEMPTABLE));
     static constexpr uint8_t heater_ttbllen_map[HOTENDS] = ARRAY_BY_HOTENDS(HEATER_0_TEMPTABLE_LEN REPEAT_S(1, HOTENDS, NEXT_TEMPTABLE_LEN));
+    #if ENABLED(FAST_THERMISTOR_LOOKUP)
+      #define NEXT_TEMPTABLE_GRID(N) ,TT_GRID(HEATER_##N##_TEMPTABLE, HEATER_##N##_TEMPTABLE_LEN)
+      static const uint8_t* heater_ttgrid_map[HOTENDS] = ARRAY_BY_HOTENDS(TT_GRID(HEATER_0_TEMPTABLE, HEATER_0_TEMPTABLE_LEN) REPEAT_S(1, HOTENDS, NEXT_TEMPTABLE_GRID));
+    #endif
   #endif
 #endif
 
@@ -316,6 +332,10 @@ volatile bool Temperature::raw_temps_ready = false;
   lpq_ptr_t Temperature::lpq_ptr = 0;
 #endif
 
+#if ENABLED(MPCTEMP)
+  int32_t Temperature::mpc_e_position; // = 0
+#endif
+
 #define TEMPDIR(N) ((HEATER_##N##_RAW_LO_TEMP) < (HEATER_##N##_RAW_HI_TEMP) ? 1 : -1)
 
 #if HAS_HOTEND
@@ -629,6 +649,7 @@ volatile bool Temperature::raw_temps_ready = false;
         goto EXIT_M303;
       }
       TERN(DWIN_CREALITY_LCD, DWIN_Update(), ui.update());
+      TERN_(LINUX_VIRTUAL_TIME, HAL_idletask()); // Simulated time only runs from the idle task
     }
 
     disable_all_heaters();
@@ -644,6 +665,253 @@ volatile bool Temperature::raw_temps_ready = false;
 
 #endif // HAS_PID_HEATING
 
+#if ENABLED(MPCTEMP)
+
+  /**
+   * MPC Autotuning (M306 T)
+   *
+   * Let the hotend cool to room temperature, then heat it at full power to
+   * over 200°C. Three points on the rise give the heat capacity and the sensor
+   * lag. Then hold it at temperature under MPC with the part fan off and at
+   * full speed, and use the power needed to find the heat lost to the air.
+   * The heater power and filament heat capacity must already be set.
+   */
+  void Temperature::MPC_autotune(const uint8_t e) {
+    hotend_info_t &hotend = temp_hotend[e];
+    MPC_t &constants = hotend.constants;
+
+    if (200 > temp_range[e].maxtemp - (HOTEND_OVERSHOOT)) {
+      SERIAL_ECHOLNPGM(STR_MPC_TEMP_TOO_HIGH);
+      return;
+    }
+
+    SERIAL_ECHOLNPAIR(STR_MPC_AUTOTUNE_START, int(e));
+
+    disable_all_heaters();
+
+    float current_temp = hotend.celsius;
+    millis_t ms = millis(), next_report_ms = ms;
+
+    // Keep temperatures, reports and the display current. True on a new sample.
+    auto housekeeping = [&]() -> bool {
+      bool sampled = false;
+      ms = millis();
+      if (raw_temps_ready) {
+        updateTemperaturesFromRawValues();
+        current_temp = hotend.celsius;
+        sampled = true;
+      }
+      if (ELAPSED(ms, next_report_ms)) {
+        next_report_ms = ms + 1000UL;
+        print_heater_states(e);
+        SERIAL_EOL();
+      }
+      TERN(DWIN_CREALITY_LCD, DWIN_Update(), ui.update());
+      TERN_(LINUX_VIRTUAL_TIME, HAL_idletask()); // Simulated time only runs from the idle task
+      return sampled;
+    };
+
+    #if HAS_FAN
+      const uint8_t fan_index = _MIN(e, FAN_COUNT - 1),
+                    old_fan_speed = fan_speed[fan_index];
+      auto set_tuning_fan = [&](const uint8_t speed) {
+        set_fan_speed(fan_index, speed);
+        planner.check_axes_activity();
+      };
+    #endif
+
+    wait_for_heatup = true; // Can be interrupted with M108
+
+    // Cool to ambient with the fan on, until the temperature stops falling for 10 seconds
+    SERIAL_ECHOLNPGM(STR_MPC_COOLING_TO_AMBIENT);
+    TERN_(HAS_FAN, set_tuning_fan(255));
+    float ambient_temp = current_temp;
+    millis_t next_test_ms = ms + 10000UL;
+    while (wait_for_heatup) {
+      housekeeping();
+      if (ELAPSED(ms, next_test_ms)) {
+        if (current_temp >= ambient_temp) {
+          ambient_temp = (ambient_temp + current_temp) * 0.5f;
+          break;
+        }
+        ambient_temp = current_temp;
+        next_test_ms += 10000UL;
+      }
+    }
+    TERN_(HAS_FAN, set_tuning_fan(0));
+
+    // Heat at full power, keeping up to 16 samples from 100°C on, at spacing that doubles as needed
+    SERIAL_ECHOLNPGM(STR_MPC_HEATING_PAST_200);
+    hotend.target = 200;  // So M105 looks sensible
+    hotend.soft_pwm_amount = (PID_MAX) >> 1;
+    const millis_t heat_start_ms = next_test_ms = ms;
+    float temp_samples[16], t1_time = 0;
+    uint8_t sample_count = 0;
+    uint16_t sample_distance = 1;
+    #if ENABLED(WATCH_HOTENDS)
+      millis_t temp_change_ms = ms + SEC_TO_MS(WATCH_TEMP_PERIOD);
+      float next_watch_temp = 0.0;
+    #endif
+    while (wait_for_heatup) {
+      housekeeping();
+
+      // Make sure heating is actually working
+      #if ENABLED(WATCH_HOTENDS)
+        if (current_temp > next_watch_temp) {                   // Over the watch temp?
+          next_watch_temp = current_temp + WATCH_TEMP_INCREASE; // - set the next temp to watch for
+          temp_change_ms = ms + SEC_TO_MS(WATCH_TEMP_PERIOD);   // - move the expiration timer up
+        }
+        else if (ELAPSED(ms, temp_change_ms))                   // Watch timer expired
+          _temp_error((heater_ind_t)e, str_t_heating_failed, GET_TEXT(MSG_HEATING_FAILED_LCD));
+      #endif
+
+      if (ELAPSED(ms, next_test_ms)) {
+        if (current_temp >= 100) {
+          if (sample_count == COUNT(temp_samples)) {
+            LOOP_L_N(i, COUNT(temp_samples) / 2) temp_samples[i] = temp_samples[i * 2];
+            sample_count /= 2;
+            sample_distance *= 2;
+          }
+          if (sample_count == 0) t1_time = (ms - heat_start_ms) * 0.001f;
+          temp_samples[sample_count++] = current_temp;
+        }
+        if (current_temp >= 200) break;
+        next_test_ms += 1000UL * sample_distance;
+      }
+      if (ELAPSED(ms, heat_start_ms + 600000UL)) {
+        SERIAL_ECHOLNPGM(STR_MPC_TIMEOUT);
+        wait_for_heatup = false;
+      }
+    }
+
+    if (!wait_for_heatup || sample_count < 3) {
+      if (wait_for_heatup) SERIAL_ECHOLNPGM(STR_MPC_TEMPERATURE_ERROR);
+      else SERIAL_ECHOLNPGM(STR_MPC_AUTOTUNE_INTERRUPTED);
+      disable_all_heaters();
+      TERN_(HAS_FAN, set_tuning_fan(old_fan_speed));
+      wait_for_heatup = false;
+      return;
+    }
+
+    const MPC_t old_constants = constants;  // Restored if the hold fails
+
+    // Fit T = asymp_temp + (ambient_temp - asymp_temp) * exp(-k * t) to three equally spaced samples
+    sample_count = (sample_count + 1) / 2 * 2 - 1;
+    const float t1 = temp_samples[0],
+                t2 = temp_samples[(sample_count - 1) >> 1],
+                t3 = temp_samples[sample_count - 1],
+                fit_curve = 2 * t2 - t1 - t3,   // Over 0 while the rise slows down
+                asymp_temp = (sq(t2) - t1 * t3) / fit_curve,
+                block_responsiveness = -logf((t2 - asymp_temp) / (t1 - asymp_temp)) / (sample_distance * (sample_count >> 1));
+
+    constants.ambient_xfer_coeff_fan0 = constants.heater_power * ((PID_MAX) >> 1) / 127 / (asymp_temp - ambient_temp);
+    constants.ambient_xfer_coeff_fan255 = constants.ambient_xfer_coeff_fan0;
+    constants.block_heat_capacity = constants.ambient_xfer_coeff_fan0 / block_responsiveness;
+    constants.sensor_responsiveness = block_responsiveness / (1 - (ambient_temp - asymp_temp) * expf(-block_responsiveness * t1_time) / (t1 - asymp_temp));
+
+    // A near-linear rise can't be fitted. Don't drive the heater with the result.
+    if (!(fit_curve > 0) || !MPC_valid(constants)) {
+      constants = old_constants;
+      SERIAL_ECHOLNPGM(STR_MPC_TEMPERATURE_ERROR);
+      disable_all_heaters();
+      TERN_(HAS_FAN, set_tuning_fan(old_fan_speed));
+      wait_for_heatup = false;
+      return;
+    }
+
+    // Hand over to MPC and measure the power needed to hold temperature, first with the fan off
+    hotend.modeled_ambient_temp = ambient_temp;
+    hotend.modeled_block_temp = asymp_temp + (ambient_temp - asymp_temp) * expf(-block_responsiveness * (ms - heat_start_ms) * 0.001f);
+    hotend.modeled_sensor_temp = current_temp;
+
+    SERIAL_ECHOLNPAIR(STR_MPC_MEASURING_AMBIENT, hotend.target);
+    constexpr millis_t settle_time = 20000UL, test_duration = 20000UL;
+    millis_t settle_end_ms = ms + settle_time,
+             test_end_ms = settle_end_ms + test_duration;
+    float total_energy_fan0 = 0, last_temp = current_temp;
+    #if HAS_FAN
+      bool fan0_done = false;
+      float total_energy_fan255 = 0;
+    #endif
+
+    while (wait_for_heatup) {
+      if (!housekeeping()) continue;
+
+      hotend.soft_pwm_amount = (int)get_pid_output_hotend(e) >> 1;
+
+      // Heat put in, less heat stored in the block
+      const float energy = constants.heater_power * hotend.soft_pwm_amount / 127 * MPC_dT + (last_temp - current_temp) * constants.block_heat_capacity;
+      last_temp = current_temp;
+
+      if (ELAPSED(ms, settle_end_ms) && !ELAPSED(ms, test_end_ms) && TERN1(HAS_FAN, !fan0_done))
+        total_energy_fan0 += energy;
+      #if HAS_FAN
+        else if (ELAPSED(ms, test_end_ms) && !fan0_done) {
+          set_tuning_fan(255);
+          settle_end_ms = ms + settle_time;
+          test_end_ms = settle_end_ms + test_duration;
+          fan0_done = true;
+        }
+        else if (ELAPSED(ms, settle_end_ms) && !ELAPSED(ms, test_end_ms))
+          total_energy_fan255 += energy;
+      #endif
+      else if (ELAPSED(ms, test_end_ms))
+        break;
+
+      if (!WITHIN(current_temp, t3 - 15, hotend.target + 15)) {
+        SERIAL_ECHOLNPGM(STR_MPC_TEMPERATURE_ERROR);
+        wait_for_heatup = false;
+      }
+    }
+
+    const bool finished = wait_for_heatup;
+    if (finished) {
+      const float temp_rise = hotend.target - ambient_temp;
+      constants.ambient_xfer_coeff_fan0 = total_energy_fan0 * 1000 / test_duration / temp_rise;
+      TERN_(HAS_FAN, constants.ambient_xfer_coeff_fan255 = total_energy_fan255 * 1000 / test_duration / temp_rise);
+    }
+    const bool valid = MPC_valid(constants);
+    if (!finished || !valid) constants = old_constants;
+
+    wait_for_heatup = false;
+    disable_all_heaters();
+    TERN_(HAS_FAN, set_tuning_fan(old_fan_speed));
+    updateMPC(e);
+
+    if (!finished) {
+      SERIAL_ECHOLNPGM(STR_MPC_AUTOTUNE_INTERRUPTED);
+      return;
+    }
+    if (!valid) {
+      SERIAL_ECHOLNPGM(STR_MPC_TEMPERATURE_ERROR);
+      return;
+    }
+
+    SERIAL_ECHOLNPGM(STR_MPC_AUTOTUNE_FINISHED);
+    log_mpc(e);
+  }
+
+  void Temperature::log_mpc(const uint8_t e, const bool eprom/*=false*/) {
+    if (eprom)
+      SERIAL_ECHOPGM("  M306 ");
+    else
+      SERIAL_ECHO_START();
+    SERIAL_CHAR('E');
+    SERIAL_CHAR('0' + e);
+
+    const MPC_t &c = temp_hotend[e].constants;
+
+    SERIAL_ECHOPAIR_F(" P", c.heater_power, 2);
+    SERIAL_ECHOPAIR_F(" C", c.block_heat_capacity, 2);
+    SERIAL_ECHOPAIR_F(" R", c.sensor_responsiveness, 4);
+    SERIAL_ECHOPAIR_F(" A", c.ambient_xfer_coeff_fan0, 4);
+    SERIAL_ECHOPAIR_F(" F", c.ambient_xfer_coeff_fan255, 4);
+    SERIAL_ECHOPAIR_F(" H", c.filament_heat_capacity_permm, 6);
+    SERIAL_EOL();
+  }
+
+#endif // MPCTEMP
+
 /**
  * Class and Instance Methods
  */
@@ -862,7 +1130,11 @@ void Temperature::min_temp_error(const heater_ind_t heater) {
 
           pid_output = work_pid[ee].Kp + work_pid[ee].Ki + work_pid[ee].Kd + float(MIN_POWER);
 
-          #if ENABLED(PID_EXTRUSION_SCALING)
+          #if BOTH(PID_EXTRUSION_SCALING, EXTRUSION_FEEDFORWARD)
+            // Filament the queued moves will push through in the next PID period
+            work_pid[ee].Kc = planner.extrusion_rate(ee) * (1.0f / nominal_filament_area) * PID_dT * PID_PARAM(Kc, ee);
+            pid_output += work_pid[ee].Kc;
+          #elif ENABLED(PID_EXTRUSION_SCALING)
             #if HOTENDS == 1
               constexpr bool this_hotend = true;
             #else
@@ -921,6 +1193,75 @@ void Temperature::min_temp_error(const heater_ind_t heater) {
         }
       #endif // PID_DEBUG
 
+    #elif ENABLED(MPCTEMP)
+
+      hotend_info_t &hotend = temp_hotend[ee];
+      const MPC_t &constants = hotend.constants;
+
+      // Start the model from the sensor after boot or a change of constants
+      if (isnan(hotend.modeled_block_temp)) {
+        hotend.modeled_ambient_temp = _MIN(30.0f, hotend.celsius);
+        hotend.modeled_sensor_temp = hotend.modeled_block_temp = hotend.celsius;
+      }
+
+      #if HOTENDS == 1
+        constexpr bool this_hotend = true;
+      #else
+        const bool this_hotend = (ee == active_extruder);
+      #endif
+
+      float ambient_xfer_coeff = constants.ambient_xfer_coeff_fan0;
+      #if HAS_FAN
+        // Use the speed the fan is running at. M106 reaches it only when the queued moves do.
+        const uint8_t fan_index = _MIN(ee, FAN_COUNT - 1),
+                      fan = planner.has_blocks_queued() ? planner.block_buffer[planner.block_buffer_tail].fan_speed[fan_index] : fan_speed[fan_index];
+        ambient_xfer_coeff += (constants.ambient_xfer_coeff_fan255 - constants.ambient_xfer_coeff_fan0) * fan * (1.0f / 255);
+      #endif
+
+      // Filament carries heat away as it is pushed through
+      float filament_xfer_coeff = 0;
+      if (this_hotend) {
+        const int32_t e_position = stepper.position(E_AXIS);
+        const float e_speed = (e_position - mpc_e_position) * planner.steps_to_mm[E_AXIS] / MPC_dT;
+        if (ABS(e_speed) > planner.settings.max_feedrate_mm_s[E_AXIS_N(ee)])
+          mpc_e_position = e_position;  // Position was reset (e.g., G92)
+        else if (e_speed > 0) {         // Retracted filament is still hot when it comes back
+          filament_xfer_coeff = e_speed * constants.filament_heat_capacity_permm;
+          mpc_e_position = e_position;
+        }
+      }
+
+      // Step the model by the power applied since the last update
+      const float blocktempdelta = (hotend.soft_pwm_amount * constants.heater_power * (1.0f / 127)
+                                    + (hotend.modeled_ambient_temp - hotend.modeled_block_temp) * (ambient_xfer_coeff + filament_xfer_coeff)
+                                   ) * MPC_dT / constants.block_heat_capacity;
+      hotend.modeled_block_temp += blocktempdelta;
+      hotend.modeled_sensor_temp += (hotend.modeled_block_temp - hotend.modeled_sensor_temp) * constants.sensor_responsiveness * MPC_dT;
+
+      // Slowly pull the model toward the sensor. Model error is corrected and noise averages out.
+      const float delta_to_apply = (hotend.celsius - hotend.modeled_sensor_temp) * (MPC_SMOOTHING_FACTOR);
+      hotend.modeled_block_temp += delta_to_apply;
+      hotend.modeled_sensor_temp += delta_to_apply;
+
+      // Blame any remaining error on the ambient estimate, but only in a steady state with the output not saturated
+      if (WITHIN(hotend.soft_pwm_amount, 1, 126) && ABS(blocktempdelta + delta_to_apply) < (MPC_STEADYSTATE) * MPC_dT)
+        hotend.modeled_ambient_temp += delta_to_apply > 0 ? _MAX(delta_to_apply, (MPC_MIN_AMBIENT_CHANGE) * MPC_dT)
+                                                          : _MIN(delta_to_apply, -(MPC_MIN_AMBIENT_CHANGE) * MPC_dT);
+
+      float power = 0;
+      if (hotend.target && !TERN0(HEATER_IDLE_HANDLER, hotend_idle[ee].timed_out)) {
+        #if ENABLED(EXTRUSION_FEEDFORWARD)
+          // Plan for the filament about to be pushed through, not what just went by
+          filament_xfer_coeff = planner.extrusion_rate(ee) * (1.0f / nominal_filament_area) * constants.filament_heat_capacity_permm;
+        #endif
+        // Close the gap to the target in about 2 seconds, plus the power lost at the target
+        power = (hotend.target - hotend.modeled_block_temp) * constants.block_heat_capacity * 0.5f
+              + (hotend.target - hotend.modeled_ambient_temp) * (ambient_xfer_coeff + filament_xfer_coeff);
+      }
+
+      float pid_output = power * 254 / constants.heater_power + 1;  // Round up to whole soft PWM counts
+      LIMIT(pid_output, 0, PID_MAX);
+
     #else // No PID enabled
 
       const bool is_idling = TERN0(HEATER_IDLE_HANDLER, hotend_idle[ee].timed_out);
@@ -1216,27 +1557,46 @@ void Temperature::manage_heater() {
 #define TEMP_AD595(RAW)  ((RAW) * 5.0 * 100.0 / float(HAL_ADC_RANGE) / (OVERSAMPLENR) * (TEMP_SENSOR_AD595_GAIN) + TEMP_SENSOR_AD595_OFFSET)
 #define TEMP_AD8495(RAW) ((RAW) * 6.6 * 100.0 / float(HAL_ADC_RANGE) / (OVERSAMPLENR) * (TEMP_SENSOR_AD8495_GAIN) + TEMP_SENSOR_AD8495_OFFSET)
 
-/**
- * Bisect search for the range of the 'raw' value, then interpolate
- * proportionally between the under and over values.
- */
-#define SCAN_THERMISTOR_TABLE(TBL,LEN) do{                            \
-  uint8_t l = 0, r = LEN, m;                                          \
-  for (;;) {                                                          \
-    m = (l + r) >> 1;                                                 \
-    if (!m) return int16_t(pgm_read_word(&TBL[0].celsius));           \
-    if (m == l || m == r) return int16_t(pgm_read_word(&TBL[LEN-1].celsius)); \
-    int16_t v00 = pgm_read_word(&TBL[m-1].value),                     \
-          v10 = pgm_read_word(&TBL[m-0].value);                       \
-         if (raw < v00) r = m;                                        \
-    else if (raw > v10) l = m;                                        \
-    else {                                                            \
-      const int16_t v01 = int16_t(pgm_read_word(&TBL[m-1].celsius)),  \
-                  v11 = int16_t(pgm_read_word(&TBL[m-0].celsius));    \
-      return v01 + (raw - v00) * float(v11 - v01) / float(v10 - v00); \
-    }                                                                 \
-  }                                                                   \
-}while(0)
+#if ENABLED(FAST_THERMISTOR_LOOKUP)
+
+  // PROGMEM reads for the tt_grid_lookup shared with the compile-time check
+  struct tt_pgm_read {
+    static int16_t value(const temp_entry_t * const t, const uint8_t i) { return pgm_read_word(&t[i].value); }
+    static int16_t celsius(const temp_entry_t * const t, const uint8_t i) { return pgm_read_word(&t[i].celsius); }
+    static uint8_t cell(const uint8_t * const g, const uint8_t c) { return pgm_read_byte(&g[c]); }
+  };
+
+  static float thermistor_grid_lookup(const temp_entry_t * const tbl, const uint8_t * const grid, const uint8_t len, const int16_t raw) {
+    return tt_grid_lookup<tt_pgm_read>(tbl, grid, len, raw);
+  }
+
+  #define SCAN_THERMISTOR_TABLE(TBL,LEN) return thermistor_grid_lookup(TBL, TT_GRID(TBL, LEN), LEN, raw)
+
+#else
+
+  /**
+   * Bisect search for the range of the 'raw' value, then interpolate
+   * proportionally between the under and over values.
+   */
+  #define SCAN_THERMISTOR_TABLE(TBL,LEN) do{                            \
+    uint8_t l = 0, r = LEN, m;                                          \
+    for (;;) {                                                          \
+      m = (l + r) >> 1;                                                 \
+      if (!m) return int16_t(pgm_read_word(&TBL[0].celsius));           \
+      if (m == l || m == r) return int16_t(pgm_read_word(&TBL[LEN-1].celsius)); \
+      int16_t v00 = pgm_read_word(&TBL[m-1].value),                     \
+            v10 = pgm_read_word(&TBL[m-0].value);                       \
+           if (raw < v00) r = m;                                        \
+      else if (raw > v10) l = m;                                        \
+      else {                                                            \
+        const int16_t v01 = int16_t(pgm_read_word(&TBL[m-1].celsius)),  \
+                    v11 = int16_t(pgm_read_word(&TBL[m-0].celsius));    \
+        return v01 + (raw - v00) * float(v11 - v01) / float(v10 - v00); \
+      }                                                                 \
+    }                                                                   \
+  }while(0)
+
+#endif
 
 #if HAS_USER_THERMISTORS
 
@@ -1310,25 +1670,117 @@ void Temperature::manage_heater() {
     SERIAL_EOL();
   }
 
-  float Temperature::user_thermistor_to_deg_c(const uint8_t t_index, const int raw) {
-    //#if (MOTHERBOARD == BOARD_RAMPS_14_EFB)
-    //  static uint32_t clocks_total = 0;
-    //  static uint32_t calls = 0;
-    //  uint32_t tcnt5 = TCNT5;
-    //#endif
+  #if ENABLED(FAST_USER_THERMISTORS)
 
-    if (!WITHIN(t_index, 0, COUNT(user_thermistor) - 1)) return 25;
+    user_thermistor_table_t Temperature::user_thermistor_table[USER_THERMISTORS];
+    uint16_t Temperature::user_thermistor_tables_pending; // = 0
 
-    user_thermistor_t &t = user_thermistor[t_index];
-    if (t.pre_calc) { // pre-calculate some variables
-      t.pre_calc     = false;
-      t.res_25_recip = 1.0f / t.res_25;
-      t.res_25_log   = logf(t.res_25);
-      t.beta_recip   = 1.0f / t.beta;
-      t.sh_alpha     = RECIPROCAL(THERMISTOR_RESISTANCE_NOMINAL_C - (THERMISTOR_ABS_ZERO_C))
-                        - (t.beta_recip * t.res_25_log) - (t.sh_c_coeff * cu(t.res_25_log));
+    /**
+     * A table build in progress. Filling a table takes thousands of formula
+     * calls, so build_user_thermistor_tables does one entry per call from
+     * idle() and readings use the formula until the table is done.
+     */
+    static struct {
+      int8_t t_index = -1;  // The table being built, or -1
+      int16_t lo,           // First reading under 999C
+              raw, step;    // The next entry and the last step
+      uint16_t n;           // Entries in this pass
+      float c,              // Celsius at 'raw'
+            tol;            // Target error for this pass
+    } table_build;
+
+    // The formula clamped to the table range. Past the top of the curve it reads 999.
+    static float table_build_celsius(const int16_t raw) {
+      return raw < table_build.lo ? 999 : constrain(thermalManager.user_thermistor_formula(table_build.t_index, raw), -1023, 999);
     }
 
+    static void table_build_pass(const float tol) {
+      table_build.tol = tol;
+      table_build.raw = _MAX(table_build.lo - 1, 0);
+      table_build.step = 1;
+      table_build.c = table_build_celsius(table_build.raw);
+      table_build.n = 0;
+    }
+
+    /**
+     * Fill the table for a user thermistor, from the last reading at 999C to
+     * the end of the range. Each step is as long as the curve stays within a
+     * target error of a straight line at its middle. The target is relaxed
+     * until the entries fit in USER_THERMISTOR_TABLE_SIZE.
+     */
+    void Temperature::build_user_thermistor_tables() {
+      constexpr int16_t raw_max = MAX_RAW_THERMISTOR_VALUE;
+      auto &b = table_build;
+
+      if (b.t_index < 0) {
+        if (!user_thermistor_tables_pending) return;
+        b.t_index = 0;
+        while (!TEST(user_thermistor_tables_pending, b.t_index)) b.t_index++;
+
+        int16_t lo = 0, hi = raw_max;
+        while (lo < hi) {                       // First reading under 999C. Past the top of the curve
+          const int16_t m = (lo + hi) / 2;      // the formula can go under absolute zero. Count that as hot.
+          const float c = user_thermistor_formula(b.t_index, m);
+          if (c < 999 && c > THERMISTOR_ABS_ZERO_C) hi = m; else lo = m + 1;
+        }
+        b.lo = lo;
+        table_build_pass(0.05f);
+        return;
+      }
+
+      user_thermistor_table_t &tbl = user_thermistor_table[b.t_index];
+      if (b.n < USER_THERMISTOR_TABLE_SIZE) {
+        tbl.raw[b.n] = b.raw;
+        tbl.celsius[b.n] = LROUND(b.c * 32);
+      }
+      b.n++;
+
+      if (b.raw >= raw_max) {
+        if (b.n <= USER_THERMISTOR_TABLE_SIZE) {
+          tbl.len = b.n;
+          CBI(user_thermistor_tables_pending, b.t_index);
+          b.t_index = -1;
+        }
+        else
+          table_build_pass(b.tol * sq(float(b.n) / (USER_THERMISTOR_TABLE_SIZE)) * 1.1f); // Entries go as 1/sqrt(tol)
+        return;
+      }
+
+      // Grow the step, then shrink it until the middle is close enough
+      int16_t step = _MIN(b.step + b.step / 2 + 1, raw_max - b.raw);
+      float c1;
+      for (;;) {
+        c1 = table_build_celsius(b.raw + step);
+        if (step < 2 || ABS(b.c + (c1 - b.c) * (step / 2) / step - table_build_celsius(b.raw + step / 2)) <= b.tol) break;
+        step = step * 3 / 4;
+      }
+      b.step = step;
+      b.raw += step;
+      b.c = c1;
+    }
+
+  #endif
+
+  void Temperature::update_user_thermistor(const uint8_t t_index, const bool build_table/*=true*/) {
+    user_thermistor_t &t = user_thermistor[t_index];
+    t.pre_calc     = false;
+    t.res_25_recip = 1.0f / t.res_25;
+    t.res_25_log   = logf(t.res_25);
+    t.beta_recip   = 1.0f / t.beta;
+    t.sh_alpha     = RECIPROCAL(THERMISTOR_RESISTANCE_NOMINAL_C - (THERMISTOR_ABS_ZERO_C))
+                      - (t.beta_recip * t.res_25_log) - (t.sh_c_coeff * cu(t.res_25_log));
+    #if ENABLED(FAST_USER_THERMISTORS)
+      user_thermistor_table[t_index].len = 0;       // Use the formula until the table is built
+      if (table_build.t_index == int8_t(t_index)) table_build.t_index = -1; // Restart a build with the old values
+      if (build_table) SBI(user_thermistor_tables_pending, t_index);
+    #else
+      UNUSED(build_table);
+    #endif
+  }
+
+  float Temperature::user_thermistor_formula(const uint8_t t_index, const int raw) {
+    const user_thermistor_t &t = user_thermistor[t_index];
+
     // maximum adc value .. take into account the over sampling
     const int adc_max = MAX_RAW_THERMISTOR_VALUE,
               adc_raw = constrain(raw, 1, adc_max - 1); // constrain to prevent divide-by-zero
@@ -1343,6 +1795,38 @@ void Temperature::manage_heater() {
       value += t.sh_c_coeff * cu(log_resistance);
     value = 1.0f / value;
 
+    // Return degrees C (up to 999, as the LCD only displays 3 digits)
+    return _MIN(value + THERMISTOR_ABS_ZERO_C, 999);
+  }
+
+  float Temperature::user_thermistor_to_deg_c(const uint8_t t_index, const int raw) {
+    //#if (MOTHERBOARD == BOARD_RAMPS_14_EFB)
+    //  static uint32_t clocks_total = 0;
+    //  static uint32_t calls = 0;
+    //  uint32_t tcnt5 = TCNT5;
+    //#endif
+
+    if (!WITHIN(t_index, 0, COUNT(user_thermistor) - 1)) return 25;
+
+    // Only M305 and settings load start a table build. Don't do it here.
+    if (user_thermistor[t_index].pre_calc) update_user_thermistor(t_index, false);
+
+    #if ENABLED(FAST_USER_THERMISTORS)
+      // Bisect for the table entries around the reading, then interpolate
+      const user_thermistor_table_t &tbl = user_thermistor_table[t_index];
+      if (!tbl.len) return user_thermistor_formula(t_index, raw);
+      uint8_t l = 0, r = tbl.len - 1;
+      if (raw <= tbl.raw[l]) return tbl.celsius[l] * (1.0f / 32);
+      if (raw >= tbl.raw[r]) return tbl.celsius[r] * (1.0f / 32);
+      while (r - l > 1) {
+        const uint8_t m = (l + r) >> 1;
+        if (raw <= tbl.raw[m]) r = m; else l = m;
+      }
+      const float value = tbl.celsius[l] + (raw - tbl.raw[l]) * float(tbl.celsius[r] - tbl.celsius[l]) / float(tbl.raw[r] - tbl.raw[l]);
+    #else
+      const float value = user_thermistor_formula(t_index, raw);
+    #endif
+
     //#if (MOTHERBOARD == BOARD_RAMPS_14_EFB)
     //  int32_t clocks = TCNT5 - tcnt5;
     //  if (clocks >= 0) {
@@ -1351,8 +1835,7 @@ void Temperature::manage_heater() {
     //  }
     //#endif
 
-    // Return degrees C (up to 999, as the LCD only displays 3 digits)
-    return _MIN(value + THERMISTOR_ABS_ZERO_C, 999);
+    return TERN(FAST_USER_THERMISTORS, value * (1.0f / 32), value);
   }
 #endif
 
@@ -1464,8 +1947,12 @@ void Temperature::manage_heater() {
 
     #if HOTEND_USES_THERMISTOR
       // Thermistor with conversion table?
-      const temp_entry_t(*tt)[] = (temp_entry_t(*)[])(heater_ttbl_map[e]);
-      SCAN_THERMISTOR_TABLE((*tt), heater_ttbllen_map[e]);
+      #if ENABLED(FAST_THERMISTOR_LOOKUP)
+        return thermistor_grid_lookup(heater_ttbl_map[e], heater_ttgrid_map[e], heater_ttbllen_map[e], raw);
+      #else
+        const temp_entry_t(*tt)[] = (temp_entry_t(*)[])(heater_ttbl_map[e]);
+        SCAN_THERMISTOR_TABLE((*tt), heater_ttbllen_map[e]);
+      #endif
     #endif
 
     return 0;
@@ -2306,7 +2793,7 @@ void Temperature::readings_ready() {
       if (tdir) {
         const int16_t rawtemp = temp_hotend[e].raw * tdir; // normal direction, +rawtemp, else -rawtemp
         const bool heater_on = (temp_hotend[e].target > 0
-          || TERN0(PIDTEMP, temp_hotend[e].soft_pwm_amount) > 0
+          || (EITHER(PIDTEMP, MPCTEMP) && temp_hotend[e].soft_pwm_amount > 0)
         );
         if (rawtemp > temp_range[e].raw_max * tdir) max_temp_error((heater_ind_t)e);
         if (heater_on && rawtemp < temp_range[e].raw_min * tdir && !is_preheating(e)) {
@@ -2407,6 +2894,7 @@ public:
  *  - Planner clean buffer
  */
 void Temperature::tick() {
+  TERN_(ISR_PROFILER, ISR_PROFILE(TEMPERATURE));
 
   static int8_t temp_count = -1;
   static ADCSensorState adc_sensor_state = StartupDelay;
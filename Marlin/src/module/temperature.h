@@ -69,6 +69,18 @@ hotend_pid_t;
   typedef IF<(LPQ_MAX_LEN > 255), uint16_t, uint8_t>::type lpq_ptr_t;
 #endif
 
+#if ENABLED(MPCTEMP)
+  // Model Predictive Control hotend model
+  typedef struct {
+    float heater_power;                 // (W) M306 P
+    float block_heat_capacity;          // (J/K) M306 C
+    float sensor_responsiveness;        // (K/s per ∆K) M306 R
+    float ambient_xfer_coeff_fan0;      // (W/K) M306 A
+    float ambient_xfer_coeff_fan255;    // (W/K) M306 F
+    float filament_heat_capacity_permm; // (J/K/mm) M306 H
+  } MPC_t;
+#endif
+
 #define PID_PARAM(F,H) _PID_##F(TERN(PID_PARAMS_PER_HOTEND, H, 0))
 #define _PID_Kp(H) TERN(PIDTEMP, Temperature::temp_hotend[H].pid.Kp, NAN)
 #define _PID_Ki(H) TERN(PIDTEMP, Temperature::temp_hotend[H].pid.Ki, NAN)
@@ -164,6 +176,11 @@ enum ADCSensorState : char {
   #define unscalePID_d(d) ( float(d) * PID_dT )
 #endif
 
+#if ENABLED(MPCTEMP)
+  #define MPC_dT ((OVERSAMPLENR * float(ACTUAL_ADC_SAMPLES)) / TEMP_TIMER_FREQUENCY)
+  #define MPC_MAX_SENSOR_RESPONSIVENESS (1.0f / (MPC_dT)) // The sensor can't follow faster than the model steps
+#endif
+
 #if BOTH(HAS_LCD_MENU, G26_MESH_VALIDATION)
   #define G26_CLICK_CAN_CANCEL 1
 #endif
@@ -190,7 +207,15 @@ struct PIDHeaterInfo : public HeaterInfo {
   T pid;  // Initialized by settings.load()
 };
 
-#if ENABLED(PIDTEMP)
+#if ENABLED(MPCTEMP)
+  // A heater controlled by its thermal model
+  typedef struct MPCHeaterInfo : public HeaterInfo {
+    MPC_t constants;                    // Initialized by settings.load()
+    float modeled_block_temp,           // NAN until the first update
+          modeled_sensor_temp,
+          modeled_ambient_temp;
+  } hotend_info_t;
+#elif ENABLED(PIDTEMP)
   typedef struct PIDHeaterInfo<hotend_pid_t> hotend_info_t;
 #else
   typedef heater_info_t hotend_info_t;
@@ -304,6 +329,15 @@ typedef struct { int16_t raw_min, raw_max, mintemp, maxtemp; } temp_range_t;
           beta, beta_recip;
   } user_thermistor_t;
 
+  #if ENABLED(FAST_USER_THERMISTORS)
+    // Table built from a user thermistor's parameters, not saved to EEPROM
+    typedef struct {
+      uint8_t len;                                  // Entries in use
+      int16_t raw[USER_THERMISTOR_TABLE_SIZE],      // Raw readings, ascending
+              celsius[USER_THERMISTOR_TABLE_SIZE];  // Temperatures in 1/32 degrees C
+    } user_thermistor_table_t;
+  #endif
+
 #endif
 
 class Temperature {
@@ -369,6 +403,8 @@ class Temperature {
       static lpq_ptr_t lpq_ptr;
     #endif
 
+    TERN_(MPCTEMP, static int32_t mpc_e_position);
+
     TERN_(HAS_HOTEND, static temp_range_t temp_range[HOTENDS]);
 
     #if HAS_HEATED_BED
@@ -427,11 +463,19 @@ class Temperature {
       static user_thermistor_t user_thermistor[USER_THERMISTORS];
       static void log_user_thermistor(const uint8_t t_index, const bool eprom=false);
       static void reset_user_thermistors();
+      static void update_user_thermistor(const uint8_t t_index, const bool build_table=true);
+      static float user_thermistor_formula(const uint8_t t_index, const int raw);
       static float user_thermistor_to_deg_c(const uint8_t t_index, const int raw);
+      #if ENABLED(FAST_USER_THERMISTORS)
+        static user_thermistor_table_t user_thermistor_table[USER_THERMISTORS];
+        static uint16_t user_thermistor_tables_pending;   // A bit for each table still to build
+        static void build_user_thermistor_tables();       // Called from idle()
+      #endif
       static bool set_pull_up_res(int8_t t_index, float value) {
         //if (!WITHIN(t_index, 0, USER_THERMISTORS - 1)) return false;
         if (!WITHIN(value, 1, 1000000)) return false;
         user_thermistor[t_index].series_res = value;
+        TERN_(FAST_USER_THERMISTORS, user_thermistor[t_index].pre_calc = true);
         return true;
       }
       static bool set_res25(int8_t t_index, float value) {
@@ -736,6 +780,29 @@ class Temperature {
 
     #endif
 
+    #if ENABLED(MPCTEMP)
+      /**
+       * Identify the hotend model in response to M306 T
+       */
+      static void MPC_autotune(const uint8_t e);
+      static void log_mpc(const uint8_t e, const bool eprom=false);
+
+      // The model needs positive constants. A NaN also fails.
+      static bool MPC_valid(const MPC_t &c) {
+        return c.heater_power > 0 && c.block_heat_capacity > 0
+            && c.sensor_responsiveness > 0 && c.sensor_responsiveness <= MPC_MAX_SENSOR_RESPONSIVENESS
+            && c.ambient_xfer_coeff_fan0 > 0 && c.ambient_xfer_coeff_fan255 > 0
+            && c.filament_heat_capacity_permm > 0;
+      }
+
+      /**
+       * Restart the model from the sensor reading when MPC values change
+       */
+      FORCE_INLINE static void updateMPC(const uint8_t e) {
+        temp_hotend[e].modeled_block_temp = NAN;
+      }
+    #endif
+
     #if ENABLED(PROBING_HEATERS_OFF)
       static void pause(const bool p);
       FORCE_INLINE static bool is_paused() { return paused; }
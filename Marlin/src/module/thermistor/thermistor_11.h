@@ -22,7 +22,7 @@
 #pragma once
 
 // R25 = 100 kOhm, beta25 = 3950 K, 4.7 kOhm pull-up, QU-BD silicone bed QWG-104F-3950 thermistor
-const temp_entry_t temptable_11[] PROGMEM = {
+constexpr temp_entry_t temptable_11[] PROGMEM = {
   { OV(   1), 938 },
   { OV(  31), 314 },
   { OV(  41), 290 },
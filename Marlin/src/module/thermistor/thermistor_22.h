@@ -21,7 +21,7 @@
  */
 
 // 100k hotend thermistor with 4.7k pull up to 3.3v and 220R to analog input as in GTM32 Pro vB
-const temp_entry_t temptable_22[] PROGMEM = {
+constexpr temp_entry_t temptable_22[] PROGMEM = {
   { OV(   1), 352 },
   { OV(   6), 341 },
   { OV(  11), 330 },
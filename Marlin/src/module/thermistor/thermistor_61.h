@@ -30,7 +30,7 @@
 // Resistance Tolerance     + / -1%
 // B Value             3950K at 25/50 deg. C
 // B Value Tolerance         + / - 1%
-const temp_entry_t temptable_61[] PROGMEM = {
+constexpr temp_entry_t temptable_61[] PROGMEM = {
   { OV(   2.00), 420 }, // Guestimate to ensure we dont lose a reading and drop temps to -50 when over
   { OV(  12.07), 350 },
   { OV(  12.79), 345 },
@@ -187,7 +187,7 @@ typedef struct { int16_t value, celsius; } temp_entry_t;
   #include "thermistor_999.h"
 #endif
 #if ANY_THERMISTOR_IS(1000) // Custom
-  const temp_entry_t temptable_1000[] PROGMEM = { { 0, 0 } };
+  constexpr temp_entry_t temptable_1000[] PROGMEM = { { 0, 0 } };
 #endif
 
 #define _TT_NAME(_N) temptable_ ## _N
@@ -494,3 +494,116 @@ static_assert(
 
 #undef _TT_REV
 #undef TT_REV
+
+#if ENABLED(FAST_THERMISTOR_LOOKUP)
+
+  /**
+   * A uniform grid over the raw ADC range, built at compile time. Each cell
+   * holds the first table segment that can contain a raw value in the cell.
+   * A conversion takes the cell with one shift, steps over any breakpoints
+   * later in the cell and interpolates the segment as the table scan does,
+   * so the result is the same and the cost is a few reads for any table.
+   *
+   * Celsius isn't resampled onto the grid. To stay within 0.1°C of the table
+   * (in 1/16°C steps) most tables need a cell per 16 raw counts, 2K of flash
+   * each, and tables 6, 13, 18, 21, 61, 66, 99, 331 and 502 need 8K to 32K.
+   * With 256 cells a cell spans at most 5 breakpoints (table 61), and most
+   * span 1 or 2.
+   */
+  #define TT_GRID_SIZE 256
+  #define TT_GRID_CELL ((MAX_RAW_THERMISTOR_VALUE + 1) / (TT_GRID_SIZE))
+
+  static_assert(!((TT_GRID_CELL) & ((TT_GRID_CELL) - 1)), "FAST_THERMISTOR_LOOKUP needs a power-of-2 raw ADC range.");
+
+  // First entry in [lo, hi) whose value isn't under 'raw', or 'hi'
+  constexpr uint8_t tt_segment(const temp_entry_t * const t, const int32_t raw, const uint8_t lo, const uint8_t hi) {
+    return lo >= hi ? hi
+         : raw <= t[(lo + hi) / 2].value ? tt_segment(t, raw, lo, (lo + hi) / 2)
+         : tt_segment(t, raw, (lo + hi) / 2 + 1, hi);
+  }
+
+  // Celsius for 'raw' on the segment ending at entry 'i', clamped to the ends of the table
+  constexpr float tt_interpolate(const temp_entry_t * const t, const uint8_t i, const int32_t raw) {
+    return raw <= t[i - 1].value ? t[i - 1].celsius
+         : raw >= t[i].value ? t[i].celsius
+         : t[i - 1].celsius + (raw - t[i - 1].value) * float(t[i].celsius - t[i - 1].celsius) / float(t[i].value - t[i - 1].value);
+  }
+
+  // The grid entry for a cell
+  constexpr uint8_t tt_grid_entry(const temp_entry_t * const t, const uint8_t len, const int32_t cell) {
+    return tt_segment(t, cell * (TT_GRID_CELL), 1, len - 1);
+  }
+
+  /**
+   * The grid lookup, used by Temperature at runtime and by the check below.
+   * The reader R gets table and grid entries, so the same code can read
+   * PROGMEM at runtime and plain constants at compile time.
+   */
+  struct tt_const_read {
+    static constexpr int16_t value(const temp_entry_t * const t, const uint8_t i) { return t[i].value; }
+    static constexpr int16_t celsius(const temp_entry_t * const t, const uint8_t i) { return t[i].celsius; }
+    static constexpr uint8_t cell(const uint8_t * const g, const uint8_t c) { return g[c]; }
+  };
+
+  constexpr float tt_lerp(const int16_t raw, const int16_t v0, const int16_t v1, const int16_t c0, const int16_t c1) {
+    return raw <= v0 ? c0                 // At or under the table start
+         : raw >= v1 ? c1                 // At or over the table end
+         : c0 + (raw - v0) * float(c1 - c0) / float(v1 - v0);
+  }
+
+  // Step over any breakpoints later in the cell
+  template<class R>
+  constexpr uint8_t tt_step(const temp_entry_t * const t, const uint8_t len, const int16_t raw, const uint8_t i) {
+    return i < len - 1 && raw > R::value(t, i) ? tt_step<R>(t, len, raw, i + 1) : i;
+  }
+
+  template<class R>
+  constexpr float tt_segment_lookup(const temp_entry_t * const t, const uint8_t i, const int16_t raw) {
+    return tt_lerp(raw, R::value(t, i - 1), R::value(t, i), R::celsius(t, i - 1), R::celsius(t, i));
+  }
+
+  template<class R>
+  constexpr float tt_grid_lookup(const temp_entry_t * const t, const uint8_t * const g, const uint8_t len, const int16_t raw) {
+    return tt_segment_lookup<R>(t, tt_step<R>(t, len, raw, R::cell(g, (raw < 0 ? 0 : raw > int16_t(MAX_RAW_THERMISTOR_VALUE) ? int16_t(MAX_RAW_THERMISTOR_VALUE) : raw) / (TT_GRID_CELL))), raw);
+  }
+
+  /**
+   * Check the grid and lookup against entries lo to hi-1 of the table, at each
+   * breakpoint and halfway along each segment. Values must not decrease.
+   */
+  constexpr bool tt_near(const float a, const float b) { return a - b <= 0.1f && b - a <= 0.1f; }
+  constexpr float tt_lookup(const temp_entry_t * const t, const uint8_t * const g, const uint8_t len, const int16_t raw) {
+    return tt_grid_lookup<tt_const_read>(t, g, len, raw);
+  }
+  constexpr bool tt_check_entry(const temp_entry_t * const t, const uint8_t * const g, const uint8_t len, const uint8_t i) {
+    return !i ? tt_near(tt_lookup(t, g, len, t[0].value), t[0].celsius)
+         : t[i].value < t[i - 1].value ? false
+         : t[i].value == t[i - 1].value ? true          // A step. The lookup takes the first entry.
+         : tt_near(tt_lookup(t, g, len, t[i].value), t[i].celsius)
+           && tt_near(tt_lookup(t, g, len, (t[i - 1].value + t[i].value) / 2), tt_interpolate(t, i, (t[i - 1].value + t[i].value) / 2));
+  }
+  constexpr bool tt_check(const temp_entry_t * const t, const uint8_t * const g, const uint8_t len, const uint8_t lo, const uint8_t hi) {
+    return hi - lo == 1 ? tt_check_entry(t, g, len, lo)
+         : tt_check(t, g, len, lo, (lo + hi) / 2) && tt_check(t, g, len, (lo + hi) / 2, hi);
+  }
+
+  #define _TTG1(T,L,N)  tt_grid_entry(T, L, N)
+  #define _TTG4(T,L,N)  _TTG1(T,L,N), _TTG1(T,L,N+1), _TTG1(T,L,N+2), _TTG1(T,L,N+3)
+  #define _TTG16(T,L,N) _TTG4(T,L,N), _TTG4(T,L,N+4), _TTG4(T,L,N+8), _TTG4(T,L,N+12)
+  #define _TTG64(T,L,N) _TTG16(T,L,N), _TTG16(T,L,N+16), _TTG16(T,L,N+32), _TTG16(T,L,N+48)
+
+  // One grid for each table in use, shared by the sensors that use it
+  template<const temp_entry_t *T, uint8_t L>
+  struct ThermistorGrid {
+    static const uint8_t* grid() {
+      static constexpr uint8_t g[TT_GRID_SIZE] PROGMEM = { _TTG64(T,L,0), _TTG64(T,L,64), _TTG64(T,L,128), _TTG64(T,L,192) };
+      static_assert(tt_check(T, g, L, 0, L), "The FAST_THERMISTOR_LOOKUP grid doesn't match a thermistor table.");
+      return g;
+    }
+  };
+  template<const temp_entry_t *T> struct ThermistorGrid<T, 0> { static const uint8_t* grid() { return nullptr; } };
+  template<const temp_entry_t *T> struct ThermistorGrid<T, 1> { static const uint8_t* grid() { return nullptr; } };
+
+  #define TT_GRID(T,L) (ThermistorGrid<T, L>::grid())
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * stepper_ports.h - Group the step pins by GPIO port for BATCHED_STEP_PULSES
+ *
+ * The HAL gives the port of a pin (GPIO_PORT) and its bit in that port
+ * (GPIO_PORT_MASK). Axes whose step pins share a port and a step polarity
+ * form a group, led by the lowest axis in it. The Stepper ISR gathers the
+ * pulses of a group into one mask and writes it to the port in one go.
+ *
+ * Everything here is constexpr, so the grouping costs nothing at runtime.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+// Axes whose step is a single pin write. Multiple drivers, a runtime-selected
+// extruder stepper, or a toggled step pin keep the per-pin STEP_WRITE.
+#define X_STEP_BATCHABLE (HAS_X_STEP && NONE(X_DUAL_STEPPER_DRIVERS, DUAL_X_CARRIAGE))
+#define Y_STEP_BATCHABLE (HAS_Y_STEP && DISABLED(Y_DUAL_STEPPER_DRIVERS))
+#define Z_STEP_BATCHABLE (HAS_Z_STEP && NUM_Z_STEPPER_DRIVERS == 1)
+#define E_STEP_BATCHABLE (HAS_E0_STEP && E_STEPPERS == 1 && NONE(LIN_ADVANCE, MIXING_EXTRUDER))
+
+#if HAS_X_STEP
+  #define _X_STEP_PIN X_STEP_PIN
+#else
+  #define _X_STEP_PIN -1
+#endif
+#if HAS_Y_STEP
+  #define _Y_STEP_PIN Y_STEP_PIN
+#else
+  #define _Y_STEP_PIN -1
+#endif
+#if HAS_Z_STEP
+  #define _Z_STEP_PIN Z_STEP_PIN
+#else
+  #define _Z_STEP_PIN -1
+#endif
+#if HAS_E0_STEP
+  #define _E_STEP_PIN E0_STEP_PIN
+#else
+  #define _E_STEP_PIN -1
+#endif
+
+constexpr bool step_pin_batchable(const AxisEnum a) {
+  return a == X_AXIS ? X_STEP_BATCHABLE : a == Y_AXIS ? Y_STEP_BATCHABLE : a == Z_AXIS ? Z_STEP_BATCHABLE : E_STEP_BATCHABLE;
+}
+
+constexpr pin_t step_pin(const AxisEnum a) {
+  return a == X_AXIS ? _X_STEP_PIN : a == Y_AXIS ? _Y_STEP_PIN : a == Z_AXIS ? _Z_STEP_PIN : _E_STEP_PIN;
+}
+
+constexpr bool step_pin_inverted(const AxisEnum a) {
+  return a == X_AXIS ? INVERT_X_STEP_PIN : a == Y_AXIS ? INVERT_Y_STEP_PIN : a == Z_AXIS ? INVERT_Z_STEP_PIN : INVERT_E_STEP_PIN;
+}
+
+constexpr uint8_t step_port(const AxisEnum a) { return GPIO_PORT(step_pin(a)); }
+constexpr uint32_t step_port_mask(const AxisEnum a) { return GPIO_PORT_MASK(step_pin(a)); }
+
+// Can axes a and b be pulsed with the same port write?
+constexpr bool step_ports_shared(const AxisEnum a, const AxisEnum b) {
+  return a != b
+      && step_pin_batchable(a) && step_pin_batchable(b)
+      && step_port(a) == step_port(b)
+      && step_pin_inverted(a) == step_pin_inverted(b);
+}
+
+// Is the axis pulsed together with at least one other axis?
+constexpr bool step_pin_batched(const AxisEnum a) {
+  return step_ports_shared(a, X_AXIS) || step_ports_shared(a, Y_AXIS)
+      || step_ports_shared(a, Z_AXIS) || step_ports_shared(a, E_AXIS);
+}
+
+// The lowest axis of the group, which holds the group's mask and does the port writes
+constexpr AxisEnum step_port_lead(const AxisEnum a) {
+  return (a > X_AXIS && step_ports_shared(a, X_AXIS)) ? X_AXIS
+       : (a > Y_AXIS && step_ports_shared(a, Y_AXIS)) ? Y_AXIS
+       : (a > Z_AXIS && step_ports_shared(a, Z_AXIS)) ? Z_AXIS
+       : a;
+}
+
+static_assert(step_pin_batched(X_AXIS) || step_pin_batched(Y_AXIS) || step_pin_batched(Z_AXIS) || step_pin_batched(E_AXIS),
+  "BATCHED_STEP_PULSES: No two step pins share a GPIO port on this board. Disable BATCHED_STEP_PULSES.");
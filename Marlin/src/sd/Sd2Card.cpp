@@ -232,6 +232,7 @@ bool Sd2Card::eraseSingleBlockEnable() {
  */
 bool Sd2Card::init(const uint8_t sckRateID, const pin_t chipSelectPin) {
   errorCode_ = type_ = 0;
+  TERN_(SD_READ_AHEAD, asyncLeft_ = 0);
   chipSelectPin_ = chipSelectPin;
   // 16-bit init start time allows over a minute
   const millis_t init_timeout = millis() + SD_INIT_TIMEOUT;
@@ -325,6 +326,7 @@ bool Sd2Card::init(const uint8_t sckRateID, const pin_t chipSelectPin) {
  * \return true for success, false for failure.
  */
 bool Sd2Card::readBlock(uint32_t blockNumber, uint8_t* dst) {
+  TERN_(SD_READ_AHEAD, readBlocksComplete());   // Let a background read finish
   if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;   // Use address if not SDHC card
 
   #if ENABLED(SD_CHECK_AND_RETRY)
@@ -428,15 +430,22 @@ bool Sd2Card::readData(uint8_t* dst) {
 #endif // SD_CHECK_AND_RETRY
 
 bool Sd2Card::readData(uint8_t* dst, const uint16_t count) {
-  bool success = false;
-
   const millis_t read_timeout = millis() + SD_READ_TIMEOUT;
   while ((status_ = spiRec()) == 0xFF) {      // Wait for start block token
     if (ELAPSED(millis(), read_timeout)) {
       error(SD_CARD_ERROR_READ_TIMEOUT);
-      goto FAIL;
+      chipDeselect();
+      return false;
     }
   }
+  return receiveData(dst, count);
+}
+
+/**
+ * Read a data block once status_ holds its start token
+ */
+bool Sd2Card::receiveData(uint8_t* dst, const uint16_t count) {
+  bool success = false;
 
   if (status_ == DATA_START_BLOCK) {
     spiRead(dst, count);                      // Transfer data
@@ -453,13 +462,13 @@ bool Sd2Card::readData(uint8_t* dst, const uint16_t count) {
   else
     error(SD_CARD_ERROR_READ);
 
-  FAIL:
   chipDeselect();
   return success;
 }
 
 /** read CID or CSR register */
 bool Sd2Card::readRegister(const uint8_t cmd, void* buf) {
+  TERN_(SD_READ_AHEAD, readBlocksComplete());   // Let a background read finish
   uint8_t* dst = reinterpret_cast<uint8_t*>(buf);
   if (cardCommand(cmd, 0)) {
     error(SD_CARD_ERROR_READ_REG);
@@ -480,6 +489,7 @@ bool Sd2Card::readRegister(const uint8_t cmd, void* buf) {
  * \return true for success, false for failure.
  */
 bool Sd2Card::readStart(uint32_t blockNumber) {
+  TERN_(SD_READ_AHEAD, readBlocksComplete());   // Let a background read finish
   if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;
 
   const bool success = !cardCommand(CMD18, blockNumber);
@@ -501,6 +511,77 @@ bool Sd2Card::readStop() {
   return success;
 }
 
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * Start reading blocks in the background. Call readBlocksBusy() until it
+   * returns false, then readBlocksComplete() for the result. Other card
+   * operations wait for the read to complete.
+   *
+   * \param[in] blockNumber Address of the first block.
+   * \param[out] dst Pointer to the location for count * 512 bytes.
+   * \param[in] count Number of blocks to read.
+   *
+   * \return true if the read started, false for failure.
+   */
+  bool Sd2Card::readBlocksStart(uint32_t blockNumber, uint8_t* dst, const uint8_t count) {
+    readBlocksComplete();
+    if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;
+
+    asyncOK_ = !cardCommand(count > 1 ? CMD18 : CMD17, blockNumber);
+    if (!asyncOK_) error(count > 1 ? SD_CARD_ERROR_CMD18 : SD_CARD_ERROR_CMD17);
+    chipDeselect();
+    asyncDst_ = dst;
+    asyncLeft_ = asyncOK_ ? count : 0;
+    asyncStop_ = count > 1;
+    asyncTimeout_ = millis() + SD_READ_TIMEOUT;
+    return asyncOK_;
+  }
+
+  /**
+   * Receive the next block if the card has it ready. The wait for
+   * the start token is spread over calls instead of spinning.
+   *
+   * The 512 bytes of a block are still received with a blocking spiRead,
+   * as no HAL has background SPI DMA. That is about 0.5ms at 8MHz SPI,
+   * so on SPI only the card's access time is taken off the main loop.
+   *
+   * \return true while blocks are still to come.
+   */
+  bool Sd2Card::readBlocksBusy() {
+    if (!asyncLeft_) return false;
+
+    chipSelect();
+    if ((status_ = spiRec()) == 0xFF) {
+      if (PENDING(millis(), asyncTimeout_)) { chipDeselect(); return true; }
+      error(SD_CARD_ERROR_READ_TIMEOUT);
+      chipDeselect();
+      asyncOK_ = false;
+    }
+    else
+      asyncOK_ = receiveData(asyncDst_, 512);
+
+    asyncDst_ += 512;
+    asyncTimeout_ = millis() + SD_READ_TIMEOUT;
+    if (asyncOK_ && --asyncLeft_) return true;
+
+    asyncLeft_ = 0;
+    if (asyncStop_ && !readStop()) asyncOK_ = false;
+    return false;
+  }
+
+  /**
+   * Wait for a background read to finish.
+   *
+   * \return true for success, false for failure.
+   */
+  bool Sd2Card::readBlocksComplete() {
+    while (readBlocksBusy()) { /* wait */ }
+    return asyncOK_;
+  }
+
+#endif // SD_READ_AHEAD
+
 /**
  * Set the SPI clock rate.
  *
@@ -540,6 +621,7 @@ bool Sd2Card::waitNotBusy(const millis_t timeout_ms) {
 bool Sd2Card::writeBlock(uint32_t blockNumber, const uint8_t* src) {
   if (ENABLED(SDCARD_READONLY)) return false;
 
+  TERN_(SD_READ_AHEAD, readBlocksComplete());   // Let a background read finish
   bool success = false;
   if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;   // Use address if not SDHC card
   if (!cardCommand(CMD24, blockNumber)) {
@@ -610,6 +692,7 @@ bool Sd2Card::writeData(const uint8_t token, const uint8_t* src) {
 bool Sd2Card::writeStart(uint32_t blockNumber, const uint32_t eraseCount) {
   if (ENABLED(SDCARD_READONLY)) return false;
 
+  TERN_(SD_READ_AHEAD, readBlocksComplete());   // Let a background read finish
   bool success = false;
   if (!cardAcmd(ACMD23, eraseCount)) {                    // Send pre-erase count
     if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;   // Use address if not SDHC card
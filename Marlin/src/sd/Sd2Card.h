@@ -93,7 +93,7 @@ uint8_t const SD_CARD_TYPE_SD1  = 1,                    // Standard capacity V1
 class Sd2Card {
 public:
 
-  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0) {}
+  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0) { TERN_(SD_READ_AHEAD, asyncLeft_ = 0); }
 
   uint32_t cardSize();
   bool erase(uint32_t firstBlock, uint32_t lastBlock);
@@ -147,6 +147,13 @@ public:
   bool readData(uint8_t* dst);
   bool readStart(uint32_t blockNumber);
   bool readStop();
+
+  #if ENABLED(SD_READ_AHEAD)
+    bool readBlocksStart(uint32_t blockNumber, uint8_t* dst, const uint8_t count);
+    bool readBlocksBusy();
+    bool readBlocksComplete();
+  #endif
+
   bool setSckRate(const uint8_t sckRateID);
 
   /**
@@ -166,6 +173,14 @@ private:
           status_,
           type_;
 
+  #if ENABLED(SD_READ_AHEAD)
+    uint8_t *asyncDst_;         // Where the next block goes
+    uint8_t asyncLeft_;         // Blocks still to come
+    bool asyncOK_,
+         asyncStop_;            // CMD12 to end a multiple block read
+    millis_t asyncTimeout_;
+  #endif
+
   // private functions
   inline uint8_t cardAcmd(const uint8_t cmd, const uint32_t arg) {
     cardCommand(CMD55, 0);
@@ -174,6 +189,7 @@ private:
   uint8_t cardCommand(const uint8_t cmd, const uint32_t arg);
 
   bool readData(uint8_t* dst, const uint16_t count);
+  bool receiveData(uint8_t* dst, const uint16_t count);
   bool readRegister(const uint8_t cmd, void* buf);
   void chipDeselect();
   void chipSelect();
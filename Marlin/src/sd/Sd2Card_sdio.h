@@ -29,11 +29,61 @@ bool SDIO_Init();
 bool SDIO_ReadBlock(uint32_t block, uint8_t *dst);
 bool SDIO_WriteBlock(uint32_t block, const uint8_t *src);
 
+#ifdef HAL_SDIO_DMA_READ
+  bool SDIO_ReadStart(uint32_t block, uint8_t *dst);  // Start a DMA block read
+  bool SDIO_ReadBusy();                               // True until the DMA is done
+  bool SDIO_ReadEnd();                                // Stop the DMA. True if the block is good.
+#endif
+
 class Sd2Card {
   public:
-    bool init(uint8_t sckRateID = 0, uint8_t chipSelectPin = 0) { return SDIO_Init(); }
-    bool readBlock(uint32_t block, uint8_t *dst) { return SDIO_ReadBlock(block, dst); }
-    bool writeBlock(uint32_t block, const uint8_t *src) { return SDIO_WriteBlock(block, src); }
+    bool init(uint8_t sckRateID = 0, uint8_t chipSelectPin = 0) { TERN_(SD_READ_AHEAD, left = 0); return SDIO_Init(); }
+    bool readBlock(uint32_t block, uint8_t *dst) { TERN_(SD_READ_AHEAD, readBlocksComplete()); return SDIO_ReadBlock(block, dst); }
+    bool writeBlock(uint32_t block, const uint8_t *src) { TERN_(SD_READ_AHEAD, readBlocksComplete()); return SDIO_WriteBlock(block, src); }
+
+    #if ENABLED(SD_READ_AHEAD)
+      // Background reads. See Sd2Card::readBlocksStart.
+      bool readBlocksStart(const uint32_t block, uint8_t *dst, const uint8_t count) {
+        readBlocksComplete();
+        pos = block; buf = dst; left = count; ok = true;
+        #ifdef HAL_SDIO_DMA_READ
+          reading = false;
+        #endif
+        return true;
+      }
+
+      // Read one block per call, with DMA if the HAL has it
+      bool readBlocksBusy() {
+        if (!left) return false;
+        #ifdef HAL_SDIO_DMA_READ
+          if (!reading) return (reading = SDIO_ReadStart(pos, buf)) || next(SDIO_ReadBlock(pos, buf));
+          if (SDIO_ReadBusy()) return true;
+          reading = false;
+          return next(SDIO_ReadEnd() || SDIO_ReadBlock(pos, buf));   // Retry with the blocking read
+        #else
+          return next(SDIO_ReadBlock(pos, buf));
+        #endif
+      }
+
+      bool readBlocksComplete() { while (readBlocksBusy()) { /* wait */ } return ok; }
+    #endif
+
+  private:
+    #if ENABLED(SD_READ_AHEAD)
+      uint32_t pos;                 // Next block to read
+      uint8_t *buf,                 // and where it goes
+              left = 0;             // Blocks still to read
+      bool ok;
+      #ifdef HAL_SDIO_DMA_READ
+        bool reading;               // DMA in progress
+      #endif
+
+      bool next(const bool good) {
+        pos++; buf += 512;
+        if (good) left--; else { ok = false; left = 0; }
+        return left;
+      }
+    #endif
 };
 
 #endif // SDIO_SUPPORT
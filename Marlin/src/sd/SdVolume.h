@@ -132,6 +132,9 @@ class SdVolume {
  private:
   // Allow SdBaseFile access to SdVolume private data.
   friend class SdBaseFile;
+  #if ENABLED(SD_READ_AHEAD)
+    friend class SdReadAhead;
+  #endif
 
   // value for dirty argument in cacheRawBlock to indicate read from cache
   static bool const CACHE_FOR_READ = false;
@@ -457,6 +457,8 @@ void CardReader::endFilePrint(TERN_(SD_RESORT, const bool re_sort/*=false*/)) {
   TERN_(DWIN_CREALITY_LCD, HMI_flag.print_finish = flag.sdprinting);
   flag.sdprinting = flag.abort_sd_printing = false;
   if (isFileOpen()) file.close();
+  TERN_(SD_READ_AHEAD, sd_read_ahead.close());
+  TERN_(SD_GCODE_CACHE, gcode_cache.close());
   TERN_(SD_RESORT, if (re_sort) presort());
 }
 
@@ -556,6 +558,8 @@ void CardReader::openFileRead(char * const path, const uint8_t subcall_type/*=0*
   if (file.open(curDir, fname, O_READ)) {
     filesize = file.fileSize();
     sdpos = 0;
+    TERN_(SD_READ_AHEAD, sd_read_ahead.open(&file));
+    TERN_(SD_GCODE_CACHE, gcode_cache.attach(curDir, fname, file));
 
     PORT_REDIRECT(SERIAL_BOTH);
     SERIAL_ECHOLNPAIR(STR_SD_FILE_OPENED, fname, STR_SD_SIZE, filesize);
@@ -591,6 +595,7 @@ void CardReader::openFileWrite(char * const path) {
   #if ENABLED(SDCARD_READONLY)
     openFailed(fname);
   #else
+    TERN_(SD_GCODE_CACHE, gcode_cache.remove(curDir, fname));   // Drop the cache of the old file
     if (file.open(curDir, fname, O_CREAT | O_APPEND | O_WRITE | O_TRUNC)) {
       flag.saving = true;
       selectFileByName(fname);
@@ -619,6 +624,7 @@ void CardReader::removeFile(const char * const name) {
     SERIAL_ECHOLNPAIR("Deletion failed (read-only), File: ", fname, ".");
   #else
     if (file.remove(curDir, fname)) {
+      TERN_(SD_GCODE_CACHE, gcode_cache.remove(curDir, fname));
       SERIAL_ECHOLNPAIR("File deleted:", fname);
       sdpos = 0;
       TERN_(SDCARD_SORT_ALPHA, presort());
@@ -43,6 +43,13 @@
 
 #include "SdFile.h"
 
+#if ENABLED(SD_GCODE_CACHE)
+  #include "gcode_cache.h"
+#endif
+#if ENABLED(SD_READ_AHEAD)
+  #include "read_ahead.h"
+#endif
+
 typedef struct {
   bool saving:1,
        logging:1,
@@ -158,10 +165,25 @@ public:
   static inline uint32_t getIndex() { return sdpos; }
   static inline uint32_t getFileSize() { return filesize; }
   static inline bool eof() { return sdpos >= filesize; }
-  static inline void setIndex(const uint32_t index) { sdpos = index; file.seekSet(index); }
+  static inline void setIndex(const uint32_t index) {
+    sdpos = index; file.seekSet(index);
+    TERN_(SD_READ_AHEAD, if (sd_read_ahead.active()) sd_read_ahead.seek(index));
+    TERN_(SD_GCODE_CACHE, gcode_cache.seek(index));
+  }
   static inline char* getWorkDirName() { workDir.getDosName(filename); return filename; }
-  static inline int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
-  static inline int16_t read(void* buf, uint16_t nbyte) { return file.isOpen() ? file.read(buf, nbyte) : -1; }
+  #if ENABLED(SD_READ_AHEAD)
+    static inline int16_t get() {
+      if (!sd_read_ahead.active()) { sdpos = file.curPosition(); return (int16_t)file.read(); }
+      sdpos = sd_read_ahead.position();
+      return sd_read_ahead.read();
+    }
+    static inline int16_t read(void* buf, uint16_t nbyte) {
+      return sd_read_ahead.active() ? sd_read_ahead.read(buf, nbyte) : file.isOpen() ? file.read(buf, nbyte) : -1;
+    }
+  #else
+    static inline int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
+    static inline int16_t read(void* buf, uint16_t nbyte) { return file.isOpen() ? file.read(buf, nbyte) : -1; }
+  #endif
   static inline int16_t write(void* buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
 
   static Sd2Card& getSd2Card() { return sd2card; }
@@ -245,6 +267,10 @@ private:
 
   static uint32_t filesize, sdpos;
 
+  #if ENABLED(SD_GCODE_CACHE)
+    friend class GCodeCache;
+  #endif
+
   //
   // Procedure calls to other files
   //
@@ -0,0 +1,406 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(SD_GCODE_CACHE)
+
+#include "gcode_cache.h"
+#include "cardreader.h"
+#include "../gcode/queue.h"
+#include "../gcode/parser.h"
+
+GCodeCache gcode_cache;
+
+SdFile GCodeCache::file;
+uint32_t GCodeCache::pos;
+
+// "MGT", version, source size, source date and time
+#define CACHE_VERSION 2
+#define HEADER_SIZE 12
+
+// Seek index at the end: GCT_INDEX_SIZE x [source pos:4][cache pos:4], unused ones 0
+#define GCT_INDEX_SIZE 32
+#define INDEX_BYTES (GCT_INDEX_SIZE * 8)
+
+// Lines compiled in each pass of the main loop
+#define GCT_LINES_PER_STEP 8
+
+// Records end where the index starts
+static inline uint32_t records_end(SdFile &f) { return f.fileSize() - INDEX_BYTES; }
+
+static void make_header(uint8_t * const h, const dir_t &d) {
+  h[0] = 'M'; h[1] = 'G'; h[2] = 'T'; h[3] = CACHE_VERSION;
+  memcpy(&h[4], &d.fileSize, 4);
+  memcpy(&h[8], &d.lastWriteDate, 2);
+  memcpy(&h[10], &d.lastWriteTime, 2);
+}
+
+/**
+ * FILE.GCO => FILE.GCT. Return false for a name that can't have a cache.
+ */
+bool GCodeCache::cache_name(char * const dst, const char * const fname) {
+  const char * const dot = strchr(fname, '.');
+  const uint8_t len = dot ? dot - fname : strlen(fname);
+  if (!WITHIN(len, 1, 8)) return false;
+  if (dot && toupper(dot[1]) == 'G' && toupper(dot[2]) == 'C' && toupper(dot[3]) == 'T' && !dot[4]) return false;
+  memcpy(dst, fname, len);
+  strcpy_P(&dst[len], PSTR(".GCT"));
+  return true;
+}
+
+/**
+ * Parse a line and write its token record. Return the record size,
+ * or 0 to keep the line as text.
+ */
+uint8_t GCodeCache::tokenize(uint8_t * const rec, char * const line) {
+  parser.parse(line);
+  if (parser.command_letter == '?' || parser.string_arg || parser.codenum > 0xFFFF) return 0;
+
+  rec[0] = GCODE_TOKEN_MARK;
+  rec[1] = parser.command_letter;
+  rec[2] = parser.codenum & 0xFF;
+  rec[3] = parser.codenum >> 8;
+  rec[4] = TERN0(USE_GCODE_SUBCODES, parser.subcode);
+  rec[5] = 0;
+  uint8_t n = 6, vals = 0;
+
+  // What the accessors give for the text, to check the record against
+  constexpr uint8_t max_vals = (MAX_CMD_SIZE - 7) / 6;
+  float fv[max_vals];
+  int32_t lv[max_vals];
+  uint32_t uv[max_vals];
+
+  for (char c = 'A'; c <= 'Z'; c++) {
+    if (!parser.seen(c)) continue;
+    if (n + 6 > MAX_CMD_SIZE - 1) return 0;
+    rec[5]++;
+    if (!parser.has_value()) { rec[n++] = c - 'A'; continue; }
+
+    // Integer accessors get the float truncated, so it must fit
+    const float f = parser.value_float();
+    if (!WITHIN(f, -2e9f, 2e9f)) return 0;
+    fv[vals] = f;
+    lv[vals] = parser.value_long();
+    uv[vals++] = parser.value_ulong();
+
+    int32_t mant;
+    const int8_t exp10 = parser.read_fixed(parser.value_string(), mant);
+    rec[n++] = (c - 'A') | 0x80;
+    memcpy(&rec[n], &mant, 4);
+    n += 4;
+    rec[n++] = exp10;
+  }
+
+  // Load the record back. Keep the text unless every value reads the same.
+  load((char*)rec);
+  vals = 0;
+  for (char c = 'A'; c <= 'Z'; c++) {
+    if (!parser.seenval(c)) continue;
+    if (parser.value_float() != fv[vals] || parser.value_long() != lv[vals] || parser.value_ulong() != uv[vals]) return 0;
+    vals++;
+  }
+  return n;
+}
+
+// State of the compile in progress. It spans many main loop passes, so it can't live on the stack.
+static struct {
+  SdFile src, dst;
+  char name[FILENAME_LENGTH];                 // FILE.GCT
+  uint8_t out[512];                           // Whole blocks are written around the volume cache, which keeps the source block
+  uint16_t n;                                 // Bytes in 'out'
+  uint32_t size;                              // Bytes of the cache so far
+  bool ok;
+  uint32_t index[GCT_INDEX_SIZE][2], stride;  // Seek index, and the lines between its entries
+  uint8_t indexed;
+  char line[MAX_CMD_SIZE];                    // The line being read
+  int count;
+  uint8_t sis;                                // Comment state for sd_line_char
+  uint32_t i, last, lines, tokens;            // Source position, last line end, and counts
+  #if ENABLED(GCODE_MOTION_MODES)
+    int16_t motion_mode_codenum;              // The file's motion mode, kept apart from the one in use
+    TERN_(USE_GCODE_SUBCODES, uint8_t motion_mode_subcode);
+  #endif
+} gct;
+
+static void put(const uint8_t b) {
+  gct.out[gct.n++] = b;
+  gct.size++;
+  if (gct.n == sizeof(gct.out)) { gct.ok &= gct.dst.write(gct.out, gct.n) == int16_t(gct.n); gct.n = 0; }
+}
+
+/**
+ * Start compiling FILE.GCO to FILE.GCT. The work is done by compile_step()
+ * from the main loop. The header is written last, so the cache can't be
+ * used until it's complete.
+ */
+bool GCodeCache::compile(char * const path) {
+  if (compiling()) {
+    SERIAL_ERROR_MSG("Already compiling ", gct.name);
+    return false;
+  }
+
+  SdFile *curDir;
+  const char * const fname = card.diveToFile(false, curDir, path);
+  if (!fname) return false;
+
+  if (!cache_name(gct.name, fname) || !gct.src.open(curDir, fname, O_READ)) {
+    SERIAL_ECHOLNPAIR(STR_SD_OPEN_FILE_FAIL, fname, ".");
+    return false;
+  }
+  if (!gct.dst.open(curDir, gct.name, O_CREAT | O_WRITE | O_TRUNC)) {
+    gct.src.close();
+    SERIAL_ECHOLNPAIR(STR_SD_OPEN_FILE_FAIL, gct.name, ".");
+    return false;
+  }
+
+  ZERO(gct.out);  // No header yet
+  gct.n = gct.size = HEADER_SIZE;
+  gct.ok = true;
+  ZERO(gct.index);
+  gct.stride = 1;
+  gct.indexed = 0;
+  gct.count = 0;
+  gct.sis = 0;
+  gct.i = gct.last = gct.lines = gct.tokens = 0;
+  TERN_(GCODE_MOTION_MODES, gct.motion_mode_codenum = -1);  // Implicit moves can't be tokenized until the file sets a motion mode
+  SERIAL_ECHOLNPAIR("Compiling ", gct.name);
+  return true;
+}
+
+/**
+ * Compile up to GCT_LINES_PER_STEP lines. Lines are split and stripped of
+ * comments the same way get_sdcard_commands() does it.
+ *
+ * This runs from the main loop between commands, so the parser isn't in
+ * use. Only the motion mode outlives a command, so the file's own motion
+ * mode is swapped in for the step.
+ */
+void GCodeCache::compile_step() {
+  if (!compiling()) return;
+
+  // The volume is gone, so there's nothing to close
+  if (!card.isMounted()) { gct.src = gct.dst = SdFile(); return; }
+
+  // Wait for SD printing or writing to finish
+  if (card.isFileOpen()) return;
+
+  #if ENABLED(GCODE_MOTION_MODES)
+    const int16_t motion_mode = parser.motion_mode_codenum;
+    parser.motion_mode_codenum = gct.motion_mode_codenum;
+    #if ENABLED(USE_GCODE_SUBCODES)
+      const uint8_t motion_sub = parser.motion_mode_subcode;
+      parser.motion_mode_subcode = gct.motion_mode_subcode;
+    #endif
+  #endif
+
+  char text[MAX_CMD_SIZE];
+  uint8_t rec[MAX_CMD_SIZE];
+  bool eof = false;
+  for (uint8_t done = 0; gct.ok && done < GCT_LINES_PER_STEP; gct.i++) {
+    const int16_t c = gct.src.read();
+    eof = c < 0;
+    if (!(eof ? (gct.line[gct.count] = '\0', true) : queue.sd_line_char(c, gct.sis, gct.line, gct.count))) continue;
+
+    if (gct.count && gct.line[0] != GCODE_TOKEN_MARK) {   // Drop junk that would look like a token
+      strcpy(text, gct.line);
+      uint8_t len = tokenize(rec, text);
+      if (len) gct.tokens++; else memcpy(rec, gct.line, len = gct.count);
+
+      // Source position of the line end, as get_sdcard_commands() would have it
+      for (uint32_t delta = gct.i - gct.last; ; delta >>= 7) {
+        put((delta & 0x7F) | (delta > 0x7F ? 0x80 : 0));
+        if (delta <= 0x7F) break;
+      }
+      gct.last = gct.i;
+      put(len);
+      LOOP_L_N(j, len) put(rec[j]);
+
+      // Index a line end every 'stride' lines. When the index fills, drop
+      // every other entry and double the stride, so it spans the whole file.
+      if (!(++gct.lines % gct.stride)) {
+        if (gct.indexed == GCT_INDEX_SIZE) {
+          LOOP_L_N(k, GCT_INDEX_SIZE / 2) COPY(gct.index[k], gct.index[k * 2 + 1]);
+          gct.indexed = GCT_INDEX_SIZE / 2;
+          gct.stride *= 2;
+        }
+        if (!(gct.lines % gct.stride)) { gct.index[gct.indexed][0] = gct.last; gct.index[gct.indexed++][1] = gct.size; }
+      }
+      done++;
+    }
+    gct.count = 0;
+    if (eof) break;
+  }
+
+  #if ENABLED(GCODE_MOTION_MODES)
+    gct.motion_mode_codenum = parser.motion_mode_codenum;
+    parser.motion_mode_codenum = motion_mode;
+    #if ENABLED(USE_GCODE_SUBCODES)
+      gct.motion_mode_subcode = parser.motion_mode_subcode;
+      parser.motion_mode_subcode = motion_sub;
+    #endif
+  #endif
+  parser.reset();   // Leave no token record as the command
+
+  if (eof || !gct.ok) finish_compile();
+}
+
+// Write the seek index and then the header, and close the files
+void GCodeCache::finish_compile() {
+  for (uint8_t k = gct.indexed; k < GCT_INDEX_SIZE; k++) gct.index[k][0] = gct.index[k][1] = 0;
+  LOOP_L_N(k, GCT_INDEX_SIZE) LOOP_L_N(j, 2) LOOP_L_N(b, 4) put(uint8_t(gct.index[k][j] >> (b * 8)));
+  if (gct.n) gct.ok &= gct.dst.write(gct.out, gct.n) == int16_t(gct.n);
+
+  dir_t d;
+  uint8_t h[HEADER_SIZE];
+  gct.ok &= gct.src.dirEntry(&d);
+  make_header(h, d);
+  gct.ok &= gct.dst.seekSet(0) && gct.dst.write(h, HEADER_SIZE) == HEADER_SIZE;
+
+  gct.src.close();
+  if (gct.ok)
+    gct.ok = gct.dst.close();
+  else
+    gct.dst.remove();
+
+  if (gct.ok)
+    SERIAL_ECHOLNPAIR("Cache ", gct.name, ": ", gct.tokens, " of ", gct.lines, " lines parsed");
+  else
+    SERIAL_ERROR_MSG("Cache write failed: ", gct.name);
+}
+
+bool GCodeCache::compiling() { return gct.src.isOpen(); }
+
+void GCodeCache::report_compile() {
+  if (compiling())
+    SERIAL_ECHOLNPAIR("Compiling ", gct.name, ": ", gct.i, "/", gct.src.fileSize());
+  else
+    SERIAL_ECHOLNPGM("Not compiling");
+}
+
+void GCodeCache::attach(SdFile *dir, const char * const fname, SdFile &src) {
+  close();
+  char name[FILENAME_LENGTH];
+  dir_t d;
+  if (!cache_name(name, fname) || !src.dirEntry(&d) || !file.open(dir, name, O_READ)) return;
+
+  uint8_t h[HEADER_SIZE], want[HEADER_SIZE];
+  make_header(want, d);
+  if (file.fileSize() >= HEADER_SIZE + INDEX_BYTES && file.read(h, HEADER_SIZE) == HEADER_SIZE && !memcmp(h, want, HEADER_SIZE)) {
+    pos = 0;
+    SERIAL_ECHO_MSG("Using cache ", name);
+  }
+  else
+    file.close();   // Stale or damaged
+}
+
+void GCodeCache::remove(SdFile *dir, const char * const fname) {
+  char name[FILENAME_LENGTH];
+  if (cache_name(name, fname)) SdFile::remove(dir, name);
+}
+
+void GCodeCache::seek(const uint32_t index) {
+  if (!active()) return;
+
+  // Start from the nearest line end at or before 'index': the current
+  // one, or the last one in the seek index
+  const uint32_t end = records_end(file);
+  uint32_t at = pos, from = file.curPosition();
+  if (at > index) { at = 0; from = HEADER_SIZE; }
+  file.seekSet(end);
+  LOOP_L_N(k, GCT_INDEX_SIZE) {
+    uint8_t e[8];
+    if (file.read(e, 8) != 8) break;
+    uint32_t src_pos, rec_pos;
+    memcpy(&src_pos, &e[0], 4);
+    memcpy(&rec_pos, &e[4], 4);
+    if (!rec_pos || src_pos > index) break;
+    if (src_pos > at) { at = src_pos; from = rec_pos; }
+  }
+
+  pos = at;
+  file.seekSet(from);
+  while (pos < index && file.curPosition() < end) {
+    uint32_t delta = 0;
+    int16_t b;
+    for (uint8_t shift = 0; shift < 32; shift += 7) {
+      if ((b = file.read()) < 0) break;
+      delta |= uint32_t(b & 0x7F) << shift;
+      if (!(b & 0x80)) break;
+    }
+    const int16_t len = file.read();
+    if (b < 0 || len < 0) break;
+    pos += delta;
+    file.seekCur(len);
+  }
+  if (pos != index) close();   // Not a line end in the cache
+}
+
+uint8_t GCodeCache::next(char * const buf) {
+  if (file.curPosition() >= records_end(file)) {
+    close();                      // Done. Skip the rest of the G-code file.
+    card.sdpos = card.filesize;
+    return 0;
+  }
+
+  uint32_t delta = 0;
+  int16_t b = 0;
+  for (uint8_t shift = 0; shift < 32; shift += 7) {
+    if ((b = file.read()) < 0) break;
+    delta |= uint32_t(b & 0x7F) << shift;
+    if (!(b & 0x80)) break;
+  }
+
+  const int16_t len = b < 0 ? -1 : file.read();
+  if (WITHIN(len, 1, MAX_CMD_SIZE - 1) && file.read(buf, len) == len) {
+    buf[len] = '\0';
+    card.sdpos = (pos += delta);
+    return len;
+  }
+
+  // Go on with the G-code file after the last line read
+  SERIAL_ERROR_MSG(STR_SD_ERR_READ);
+  close();
+  card.setIndex(pos);
+  return 0;
+}
+
+void GCodeCache::load(char * const rec) {
+  const uint8_t *r = (const uint8_t*)rec;
+  parser.set_command(r[1], r[2] | (r[3] << 8), r[4]);
+  parser.command_ptr = rec;   // For process_subcommands_now to load it again
+  r += 6;
+  for (uint8_t i = ((const uint8_t*)rec)[5]; i--;) {
+    const uint8_t p = *r++;
+    const char c = 'A' + (p & 0x7F);
+    if (p & 0x80) {
+      int32_t mant;
+      memcpy(&mant, r, 4);
+      parser.set_value(c, parser.fixed_to_float(mant, int8_t(r[4])));
+      r += 5;
+    }
+    else
+      parser.set_flag(c);
+  }
+}
+
+#endif // SD_GCODE_CACHE
@@ -0,0 +1,103 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * gcode_cache.h - Pre-parsed G-code for SD printing
+ *
+ * M36 compiles FILE.GCO into FILE.GCT in the same folder. The compile runs
+ * a few lines at a time from the main loop, between commands, and waits
+ * while a file is being printed or written. The cache holds one record for
+ * each line that get_sdcard_commands() would queue:
+ *
+ *   [pos][len][data]   pos: Source position of the line end, as a delta varint
+ *                      len: Size of data, less than MAX_CMD_SIZE
+ *                     data: The line text, or a token record:
+ *
+ *   [GCODE_TOKEN_MARK][letter][codenum:2][subcode][count][param]...
+ *   param: [letter - 'A'] with bit 7 set if a value follows as [mantissa:4][exp10]
+ *
+ * The mantissa and exponent are those GCodeParser::read_fixed gets from the
+ * text, so a loaded value is the same float that parsing gives. Each record
+ * is loaded back when it's made, and a line is kept as text if it has a
+ * string argument or any value that reads differently from the record.
+ *
+ * The records are followed by a seek index of up to 32 line ends spread
+ * over the file, each as [source pos:4][cache pos:4], with unused ones 0.
+ *
+ * CardReader's sdpos follows the source file, so progress, M27 and
+ * PrintJobRecovery work the same with the cache. A seek starts from the
+ * nearest indexed line end. Seeking to a position that isn't a line end in
+ * the cache returns to reading the G-code file.
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "SdFile.h"
+
+#define GCODE_TOKEN_MARK 0x01
+
+class GCodeCache {
+public:
+  // Start compiling a G-code file by path. Return false on failure.
+  static bool compile(char * const path);
+
+  // Compile some more lines (main loop, between commands)
+  static void compile_step();
+
+  static bool compiling();
+  static void report_compile();
+
+  // Start using the cache for 'fname' in 'dir', if there's a current one
+  static void attach(SdFile *dir, const char * const fname, SdFile &src);
+
+  // Delete the cache for 'fname' when the G-code file is replaced or removed
+  static void remove(SdFile *dir, const char * const fname);
+
+  static void close() { if (file.isOpen()) file.close(); }
+
+  static inline bool active() { return file.isOpen(); }
+
+  // Go to the line ending at 'pos' in the source, or stop using the cache
+  static void seek(const uint32_t pos);
+
+  /**
+   * Get the next line or token record into 'buf', nul-terminated.
+   * Return its length, or 0 when the cache is done or fails. It is done if
+   * card.eof() is true. If it fails, CardReader goes on with the G-code file.
+   */
+  static uint8_t next(char * const buf);
+
+  // Load a token record into the parser. The record stays the command_ptr.
+  static void load(char * const rec);
+
+  static inline bool is_token(const char * const rec) { return *rec == GCODE_TOKEN_MARK; }
+
+private:
+  static SdFile file;
+  static uint32_t pos;          // Source position of the last record read
+
+  static bool cache_name(char * const dst, const char * const fname);
+  static void finish_compile();
+  static uint8_t tokenize(uint8_t * const rec, char * const line);
+};
+
+extern GCodeCache gcode_cache;
@@ -0,0 +1,169 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(SD_READ_AHEAD)
+
+#include "read_ahead.h"
+#include "../module/temperature.h"
+
+SdReadAhead sd_read_ahead;
+
+uint32_t SdReadAhead::underruns;
+SdBaseFile *SdReadAhead::file;
+uint8_t SdReadAhead::buf[SD_READ_AHEAD_BUFFERS][SD_READ_AHEAD_BLOCKS * 512] __attribute__((aligned(4)));   // For SDIO DMA
+uint16_t SdReadAhead::size[SD_READ_AHEAD_BUFFERS], SdReadAhead::index;
+uint8_t SdReadAhead::head, SdReadAhead::count;
+uint32_t SdReadAhead::pos, SdReadAhead::fill_pos, SdReadAhead::fill_start, SdReadAhead::cluster,
+         SdReadAhead::run_last, SdReadAhead::run_next;
+uint8_t *SdReadAhead::fill_dst, SdReadAhead::want, SdReadAhead::run;
+
+void SdReadAhead::open(SdBaseFile * const f) {
+  close();
+  file = f;
+  underruns = 0;
+  seek(0);
+}
+
+void SdReadAhead::close() {
+  cancel();
+  file = nullptr;
+}
+
+// Drop the fill in progress. The card can't go on writing to the buffer.
+void SdReadAhead::cancel() {
+  if (run) file->volume()->sdCard()->readBlocksComplete();
+  want = run = 0;
+}
+
+void SdReadAhead::seek(const uint32_t p) {
+  cancel();
+  head = count = 0;
+  pos = p;
+  index = p & 0x1FF;              // Start in the middle of the first block
+  fill_pos = p - index;
+  cluster = 0;
+}
+
+/**
+ * Take one step on the next empty buffer: start a read, poll the one in
+ * progress, or take its blocks and start the next. Each run of blocks in
+ * consecutive clusters takes one CMD18.
+ *
+ * Return true while the buffer is being filled, false once it's full,
+ * when there's nothing to fill, or on failure.
+ */
+bool SdReadAhead::fill_step() {
+  if (!file) return false;
+
+  SdVolume * const vol = file->volume();
+  Sd2Card * const sd = vol->sdCard();
+  const uint32_t file_size = file->fileSize();
+  auto fail = [&]{ fill_pos = fill_start; cluster = 0; want = run = 0; return false; };   // Retry the buffer later
+
+  if (run) {                      // A read is in progress
+    if (sd->readBlocksBusy()) return true;
+    if (!sd->readBlocksComplete()) return fail();
+    want -= run;
+    fill_pos += uint32_t(run) << 9;
+    fill_dst += uint16_t(run) << 9;
+    run = 0;
+    cluster = run_last;
+    if (!vol->blockOfCluster(fill_pos) && fill_pos < file_size) {   // On to a new cluster
+      if (!run_next && !vol->fatGet(run_last, &run_next)) return fail();
+      cluster = run_next;
+    }
+    if (!want) {                  // The buffer is full
+      size[(head + count) % (SD_READ_AHEAD_BUFFERS)] = _MIN(fill_pos, file_size) - fill_start;
+      count++;
+      return false;
+    }
+  }
+  else if (!want) {               // Begin the next empty buffer
+    if (count >= SD_READ_AHEAD_BUFFERS || fill_pos >= file_size) return false;
+    if (!cluster) {               // Walk the chain to fill_pos
+      cluster = file->firstCluster();
+      for (uint32_t n = fill_pos >> (9 + vol->clusterSizeShift()); n--;)
+        if (!vol->fatGet(cluster, &cluster)) { cluster = 0; return false; }
+    }
+    fill_start = fill_pos;
+    fill_dst = buf[(head + count) % (SD_READ_AHEAD_BUFFERS)];
+    want = _MIN(uint32_t(SD_READ_AHEAD_BLOCKS), (file_size - fill_pos + 511) >> 9);
+  }
+
+  // Take blocks to the end of the cluster, and on into the next if it follows
+  const uint8_t first = vol->blockOfCluster(fill_pos);
+  run = _MIN(want, vol->blocksPerCluster() - first);
+  run_last = cluster;
+  run_next = 0;
+  while (run < want) {
+    if (!vol->fatGet(run_last, &run_next)) return fail();
+    if (run_next != run_last + 1) break;
+    run_last = run_next;
+    run_next = 0;
+    run = _MIN(want, run + vol->blocksPerCluster());
+  }
+
+  if (!sd->readBlocksStart(vol->clusterStartBlock(cluster) + first, fill_dst, run)) return fail();
+  return true;
+}
+
+int16_t SdReadAhead::read() {
+  if (pos >= file->fileSize()) return -1;
+  if (!count) {
+    underruns++;
+    while (fill_step()) thermalManager.manage_heater();
+    if (!count) return -1;
+  }
+  const uint8_t c = buf[head][index];
+  pos++;
+  if (++index >= size[head]) {
+    index = 0;
+    head = (head + 1) % (SD_READ_AHEAD_BUFFERS);
+    count--;
+  }
+  return c;
+}
+
+int16_t SdReadAhead::read(void * const dst, uint16_t nbyte) {
+  uint8_t *d = (uint8_t*)dst;
+  for (; nbyte; nbyte--) {
+    const int16_t c = read();
+    if (c < 0) break;
+    *d++ = c;
+  }
+  return d - (uint8_t*)dst;
+}
+
+uint32_t SdReadAhead::level() {
+  uint32_t n = 0;
+  for (uint8_t i = 0; i < count; i++) n += size[(head + i) % (SD_READ_AHEAD_BUFFERS)];
+  return count ? n - index : 0;
+}
+
+void SdReadAhead::report() {
+  SERIAL_ECHO_MSG("SD read-ahead: ", level(), " bytes ready, ", underruns, " underruns");
+}
+
+#endif // SD_READ_AHEAD
@@ -0,0 +1,88 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * read_ahead.h - Multi-block read-ahead for SD printing
+ *
+ * The file being printed is read with multi-block reads (CMD18) into
+ * SD_READ_AHEAD_BUFFERS rotating buffers of SD_READ_AHEAD_BLOCKS blocks each.
+ * Empty buffers are filled in idle time while commands are read from the full
+ * ones. A read only waits for the card when all the buffers are empty, and
+ * keeps the heaters managed while it waits.
+ *
+ * Fills use the background block reads of Sd2Card. Each idle() call takes one
+ * step: start a read, poll it, or take the blocks it got. The card's access
+ * time and, with SDIO DMA, the transfer itself overlap with planning.
+ *
+ * Reads go around the SdVolume block cache, so the file must not be
+ * written while it's followed.
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "SdBaseFile.h"
+
+class SdReadAhead {
+public:
+  static uint32_t underruns;      // Reads that had to wait for a fill
+
+  // Follow a file from its start
+  static void open(SdBaseFile * const f);
+  static void close();
+  static inline bool active() { return file != nullptr; }
+
+  static void seek(const uint32_t pos);
+  static inline uint32_t position() { return pos; }
+
+  // Get the next byte, or -1 at the end of the file or on a read error
+  static int16_t read();
+  static int16_t read(void * const buf, uint16_t nbyte);
+
+  // Take a step on filling the empty buffers. Call in idle time.
+  static inline void fill() { fill_step(); }
+
+  // Bytes read ahead and ready to use
+  static uint32_t level();
+
+  static void report();
+
+private:
+  static SdBaseFile *file;
+  static uint8_t buf[SD_READ_AHEAD_BUFFERS][SD_READ_AHEAD_BLOCKS * 512];
+  static uint16_t size[SD_READ_AHEAD_BUFFERS],  // Bytes of the file in each buffer
+                  index;                        // Read index in the head buffer
+  static uint8_t head,                          // Buffer being read
+                 count;                         // Full buffers, from the head
+  static uint32_t pos,                          // File position of the next read
+                  fill_pos,                     // File position of the next fill, on a block boundary
+                  fill_start,                   // File position of the buffer being filled
+                  cluster,                      // Cluster holding fill_pos, or 0 to look up
+                  run_last, run_next;           // Last cluster of the read in progress, and the one after if known
+  static uint8_t *fill_dst,                     // Where the read in progress goes
+                 want,                          // Blocks still to read into the buffer being filled
+                 run;                           // Blocks in the read in progress
+
+  static bool fill_step();
+  static void cancel();
+};
+
+extern SdReadAhead sd_read_ahead;
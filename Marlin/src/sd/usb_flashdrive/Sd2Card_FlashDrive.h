@@ -47,6 +47,7 @@
 class Sd2Card {
   private:
     uint32_t pos;
+    TERN_(SD_READ_AHEAD, bool readOK);
 
     static void usbStateDebug();
 
@@ -61,6 +62,16 @@ class Sd2Card {
     inline bool readData(uint8_t* dst)                           { return readBlock(pos++, dst); }
     inline bool readStop() const                                 { return true; }
 
+    #if ENABLED(SD_READ_AHEAD)
+      // Blocks are read on start. See Sd2Card::readBlocksStart.
+      inline bool readBlocksStart(uint32_t block, uint8_t* dst, uint8_t count) {
+        for (readOK = true; readOK && count--; dst += 512) readOK = readBlock(block++, dst);
+        return readOK;
+      }
+      inline bool readBlocksBusy() const                         { return false; }
+      inline bool readBlocksComplete() const                     { return readOK; }
+    #endif
+
     inline bool writeStart(const uint32_t block, const uint32_t) { pos = block; return ready(); }
     inline bool writeData(uint8_t* src)                          { return writeBlock(pos++, src); }
     inline bool writeStop() const                                { return true; }
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+#
+# Decode the binary GPIO trace written by the native Linux build with
+# GPIO_LOGGING enabled (format in Marlin/src/HAL/LINUX/hardware/IOLoggerTrace.h)
+#
+# Invocation:
+#   decodeStepTrace.py trace.bin             Print the events as CSV: time (ns), pin, event, value
+#   decodeStepTrace.py -s trace.bin          Count the events of each pin
+#   decodeStepTrace.py -c old.bin new.bin    Show the first event where two traces differ
+#
+import sys
+import struct
+import argparse
+import itertools
+
+MAGIC = b'MRLNTRC\x02'
+HEADER_SIZE = 24
+EVENTS = ('NOP', 'FALL', 'RISE', 'SET_VALUE', 'SETM', 'SETD')
+SET_VALUE = 3
+
+def varint(data, i):
+    v = shift = 0
+    while True:
+        b = data[i]
+        i += 1
+        v |= (b & 0x7F) << shift
+        shift += 7
+        if b < 0x80:
+            return v, i
+
+def events(filename):
+    """Yield (time, pin, event, value) for each record in the trace"""
+    with open(filename, 'rb') as f:
+        data = f.read()
+    if data[:8] != MAGIC:
+        sys.exit("%s is not a Marlin GPIO trace" % filename)
+    length, dropped = struct.unpack_from('<QQ', data, 8)
+    if dropped:
+        print("warning: %s is incomplete, %d events were dropped" % (filename, dropped), file=sys.stderr)
+    end = HEADER_SIZE + length
+    i, t = HEADER_SIZE, 0
+    while i < end:
+        delta, i = varint(data, i)
+        t += (delta >> 1) ^ -(delta & 1)
+        pin, event = data[i], data[i + 1]
+        i += 2
+        if event >= SET_VALUE:
+            value, i = varint(data, i)
+        else:
+            value = 1 if event == 2 else 0
+        yield t, pin, event, value
+
+def event_name(event):
+    return EVENTS[event] if event < len(EVENTS) else str(event)
+
+def print_csv(filename):
+    for t, pin, event, value in events(filename):
+        print("%d, %d, %s, %d" % (t, pin, event_name(event), value))
+
+def summary(filename):
+    counts = {}
+    last = 0
+    for t, pin, event, value in events(filename):
+        counts.setdefault(pin, [0] * len(EVENTS))[min(event, len(EVENTS) - 1)] += 1
+        last = t
+    print("pin  " + "".join("%12s" % e for e in EVENTS))
+    for pin in sorted(counts):
+        print("%3d  " % pin + "".join("%12d" % n for n in counts[pin]))
+    print("last event at %.6f s" % (last / 1e9))
+
+def compare(old, new):
+    n = 0
+    for a, b in itertools.zip_longest(events(old), events(new)):
+        if a != b:
+            show = lambda e: "end of trace" if e is None else "%d ns pin %d %s %d" % (e[0], e[1], event_name(e[2]), e[3])
+            print("traces differ at event %d" % n)
+            print("  %s: %s" % (old, show(a)))
+            print("  %s: %s" % (new, show(b)))
+            return 1
+        n += 1
+    print("traces match (%d events)" % n)
+    return 0
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a Marlin GPIO trace")
+    parser.add_argument('trace')
+    parser.add_argument('other', nargs='?')
+    parser.add_argument('-s', '--summary', action='store_true', help="count the events of each pin")
+    parser.add_argument('-c', '--compare', action='store_true', help="compare with the other trace")
+    args = parser.parse_args()
+
+    if args.compare:
+        if not args.other: parser.error("--compare needs two traces")
+        return compare(args.trace, args.other)
+    if args.summary:
+        summary(args.trace)
+    else:
+        print_csv(args.trace)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())